@@ -0,0 +1,273 @@
+#include "AutoTuner.hpp"
+#include "ErrorMetrics.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// Constructor
+AutoTuner::AutoTuner(shared_ptr<const ImageStatistics> _statistics, int _threadCount)
+    : statistics(_statistics), leafModel(LeafModel::FLAT),
+      partitionMode(QuadTree::QUADRANT), splitGrid(0), threadCount(_threadCount), elapsedMs(0) {
+}
+
+void AutoTuner::addCandidate(QuadTree::ErrorMetricType method, double threshold, int minBlockSize) {
+    Candidate candidate;
+    candidate.method = method;
+    candidate.threshold = threshold;
+    candidate.minBlockSize = minBlockSize;
+    candidate.nodeCount = 0;
+    candidate.maxDepth = 0;
+    candidate.estimatedSize = 0;
+    candidate.psnr = 0.0;
+    candidate.ssim = 0.0;
+    candidate.evaluated = false;
+    candidate.paretoOptimal = false;
+    candidate.timeMs = 0;
+    candidate.outputSize = 0;
+    candidates.push_back(candidate);
+}
+
+void AutoTuner::setImportanceMap(shared_ptr<const ImportanceMap> map) {
+    importanceMap = map;
+}
+
+void AutoTuner::setLeafModel(LeafModel::Type type) {
+    leafModel = type;
+}
+
+void AutoTuner::setPartitionMode(QuadTree::PartitionMode mode) {
+    partitionMode = mode;
+}
+
+void AutoTuner::setSplitGrid(int grid) {
+    splitGrid = grid;
+}
+
+void AutoTuner::setTreeHandler(const function<void(Candidate&, const QuadTree&, const unsigned char*)>& handler) {
+    treeHandler = handler;
+}
+
+// Grid default: threshold diambil secara geometris di dalam batas setiap metrik
+void AutoTuner::addDefaultCandidates() {
+    const QuadTree::ErrorMetricType methods[] = {
+        QuadTree::VARIANCE, QuadTree::MEAN_ABSOLUTE_DEVIATION, QuadTree::MAX_PIXEL_DIFFERENCE,
+        QuadTree::ENTROPY, QuadTree::SSIM
+    };
+    const int blockSizes[] = { 4, 16, 64 };
+    const int thresholdSteps = 6;
+
+    for (QuadTree::ErrorMetricType method : methods) {
+        double minThreshold, maxThreshold;
+        Utils::getThresholdLimits(method, minThreshold, maxThreshold);
+        double low = minThreshold > 0.0 ? minThreshold : maxThreshold / 200.0;
+
+        for (int i = 0; i < thresholdSteps; i++) {
+            double t = low * std::pow(maxThreshold / low, static_cast<double>(i) / (thresholdSteps - 1));
+            for (int blockSize : blockSizes) {
+                addCandidate(method, t, blockSize);
+            }
+        }
+    }
+}
+
+// Evaluasi seluruh kandidat, setiap worker membangun tree-nya sendiri
+void AutoTuner::run() {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    Utils::parallelFor(static_cast<int>(candidates.size()), threadCount, [this](int index) {
+        evaluate(candidates[index]);
+    });
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+
+    markParetoFront();
+}
+
+const vector<AutoTuner::Candidate>& AutoTuner::getCandidates() const {
+    return candidates;
+}
+
+long long AutoTuner::getElapsedMs() const {
+    return elapsedMs;
+}
+
+void AutoTuner::evaluate(Candidate& candidate) const {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    try {
+        QuadTree tree(statistics, candidate.minBlockSize, candidate.threshold, candidate.method);
+        tree.setImportanceMap(importanceMap);
+        tree.setLeafModel(leafModel);
+        tree.setPartitionMode(partitionMode);
+        tree.setSplitGrid(splitGrid);
+        tree.buildTree();
+
+        // Satu raster dipakai untuk metrik kualitas dan untuk output kandidat
+        vector<unsigned char> compressed(static_cast<size_t>(tree.getWidth()) * tree.getHeight() * 3);
+        tree.rasterize(compressed.data(), 3);
+        candidate.nodeCount = tree.getNodeCount();
+        candidate.maxDepth = tree.getMaxDepth();
+        candidate.estimatedSize = tree.getEstimatedCompressedSize();
+        candidate.psnr = ErrorMetrics::calculatePSNR(statistics->getImage(), compressed.data());
+        candidate.ssim = ErrorMetrics::calculateImageSSIM(statistics->getImage(), compressed.data());
+        candidate.evaluated = true;
+
+        if (treeHandler) {
+            treeHandler(candidate, tree, compressed.data());
+        }
+    } catch (const std::exception&) {
+        candidate.evaluated = false;
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    candidate.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+}
+
+// Ukuran output terukur jika tree handler mengisinya, selain itu estimasi dari jumlah node
+size_t AutoTuner::getSize(const Candidate& candidate) {
+    return candidate.outputSize > 0 ? candidate.outputSize : candidate.estimatedSize;
+}
+
+// Kandidat optimal jika tidak ada kandidat lain yang lebih kecil atau sama
+// ukurannya dan sekaligus tidak lebih buruk PSNR maupun SSIM-nya
+void AutoTuner::markParetoFront() {
+    for (Candidate& a : candidates) {
+        a.paretoOptimal = a.evaluated;
+        if (!a.evaluated) continue;
+
+        for (const Candidate& b : candidates) {
+            if (&a == &b || !b.evaluated) continue;
+
+            bool notWorse = getSize(b) <= getSize(a) && b.psnr >= a.psnr && b.ssim >= a.ssim;
+            bool better = getSize(b) < getSize(a) || b.psnr > a.psnr || b.ssim > a.ssim;
+            if (notWorse && better) {
+                a.paretoOptimal = false;
+                break;
+            }
+        }
+    }
+}
+
+int AutoTuner::selectBest(GoalType goal, double target) const {
+    int best = -1;
+    int fallback = -1;
+
+    for (int i = 0; i < static_cast<int>(candidates.size()); i++) {
+        const Candidate& c = candidates[i];
+        if (!c.evaluated) continue;
+
+        if (goal == TARGET_SIZE) {
+            if (getSize(c) <= target &&
+                (best < 0 || c.psnr > candidates[best].psnr)) {
+                best = i;
+            }
+            // Jika tidak ada yang memenuhi, ambil yang terkecil
+            if (fallback < 0 || getSize(c) < getSize(candidates[fallback])) {
+                fallback = i;
+            }
+        } else if (goal == TARGET_PSNR || goal == TARGET_SSIM) {
+            double quality = (goal == TARGET_PSNR) ? c.psnr : c.ssim;
+            if (quality >= target &&
+                (best < 0 || getSize(c) < getSize(candidates[best]))) {
+                best = i;
+            }
+            // Jika tidak ada yang memenuhi, ambil kualitas tertinggi
+            double fallbackQuality = fallback < 0 ? 0.0 :
+                (goal == TARGET_PSNR ? candidates[fallback].psnr : candidates[fallback].ssim);
+            if (fallback < 0 || quality > fallbackQuality) {
+                fallback = i;
+            }
+        }
+    }
+
+    return best >= 0 ? best : fallback;
+}
+
+void AutoTuner::displayReport() const {
+    vector<const Candidate*> front;
+    int evaluatedCount = 0;
+    for (const Candidate& c : candidates) {
+        if (c.evaluated) evaluatedCount++;
+        if (c.paretoOptimal) front.push_back(&c);
+    }
+    std::sort(front.begin(), front.end(), [](const Candidate* a, const Candidate* b) {
+        return getSize(*a) < getSize(*b);
+    });
+
+    std::cout << "\n=== Autotune Results ===" << std::endl;
+    std::cout << "Candidates evaluated : " << evaluatedCount << " of " << candidates.size() << std::endl;
+    std::cout << "Tuning time          : " << elapsedMs << " ms" << std::endl;
+    std::cout << "Pareto front (output size in bytes vs PSNR/SSIM):" << std::endl;
+    // Tabel diformat di stream lokal agar state format std::cout (dipakai bersama worker batch) tidak berubah
+    std::ostringstream table;
+    table << std::left << std::setw(26) << "  Method" << std::right
+          << std::setw(11) << "Threshold" << std::setw(7) << "Block"
+          << std::setw(9) << "Nodes" << std::setw(7) << "Depth"
+          << std::setw(11) << "Size" << std::setw(9) << "PSNR" << std::setw(8) << "SSIM" << "\n";
+
+    for (const Candidate* c : front) {
+        table << std::left << std::setw(26) << ("  " + Utils::errorMetricToString(c->method).substr(0, 22))
+              << std::right << std::fixed
+              << std::setw(11) << std::setprecision(3) << c->threshold
+              << std::setw(7) << c->minBlockSize
+              << std::setw(9) << c->nodeCount
+              << std::setw(7) << c->maxDepth
+              << std::setw(11) << getSize(*c)
+              << std::setw(9) << std::setprecision(2) << c->psnr
+              << std::setw(8) << std::setprecision(4) << c->ssim << "\n";
+    }
+    std::cout << table.str() << std::flush;
+}
+
+bool AutoTuner::writeCsv(const string& path) const {
+    std::ofstream csv(path);
+    if (!csv.good()) {
+        std::cerr << "Error: Cannot open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    // Nomor metode sama dengan opsi -m
+    csv << "method,method_name,threshold,min_block,nodes,depth,estimated_size,output_size,psnr,ssim,time_ms,output\n";
+    for (const Candidate& c : candidates) {
+        csv << (static_cast<int>(c.method) + 1) << "," << Utils::errorMetricToString(c.method) << ","
+            << c.threshold << "," << c.minBlockSize << ",";
+        if (c.evaluated) {
+            csv << c.nodeCount << "," << c.maxDepth << "," << c.estimatedSize << "," << c.outputSize << ","
+                << std::fixed << std::setprecision(4) << c.psnr << "," << c.ssim << std::defaultfloat;
+        } else {
+            csv << ",,,,,";
+        }
+        csv << "," << c.timeMs << "," << c.outputPath << "\n";
+    }
+    csv.flush();
+    if (!csv.good()) {
+        std::cerr << "Error: Failed to write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool AutoTuner::parseGoal(const string& text, GoalType& goal, double& target) {
+    size_t separator = text.find(':');
+    if (separator == string::npos) {
+        return false;
+    }
+
+    string type = text.substr(0, separator);
+    try {
+        target = std::stod(text.substr(separator + 1));
+    } catch (const std::exception&) {
+        return false;
+    }
+
+    if (type == "psnr") goal = TARGET_PSNR;
+    else if (type == "ssim") goal = TARGET_SSIM;
+    else if (type == "size") goal = TARGET_SIZE;
+    else return false;
+
+    return true;
+}
@@ -0,0 +1,166 @@
+#ifndef __AUTO_TUNER__HPP__
+#define __AUTO_TUNER__HPP__
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include "QuadTree.hpp"
+#include "ImageStatistics.hpp"
+
+using namespace std;
+
+/**
+ * @class AutoTuner
+ * @brief Kelas untuk mencari kombinasi metode, threshold, dan ukuran blok minimum
+ *        secara paralel di atas statistik gambar yang dihitung sekali
+ */
+class AutoTuner {
+public:
+
+    enum GoalType {
+        NO_GOAL,        // Hanya laporkan Pareto front
+        TARGET_PSNR,    // Ukuran terkecil dengan PSNR >= target
+        TARGET_SSIM,    // Ukuran terkecil dengan SSIM >= target
+        TARGET_SIZE     // PSNR tertinggi dengan ukuran <= target (bytes)
+    };
+
+    // Hasil evaluasi satu kombinasi parameter
+    struct Candidate {
+        QuadTree::ErrorMetricType method;
+        double threshold;
+        int minBlockSize;
+        int nodeCount;
+        int maxDepth;
+        size_t estimatedSize;
+        double psnr;
+        double ssim;
+        bool evaluated;
+        bool paretoOptimal;
+        long long timeMs;       // Waktu build, evaluasi, dan penanganan tree kandidat
+        string outputPath;      // Diisi oleh tree handler jika tree disimpan
+        size_t outputSize;      // Ukuran output sebenarnya (file atau hasil encode di memori), diisi tree handler
+    };
+
+private:
+    shared_ptr<const ImageStatistics> statistics; // Statistik gambar yang dipakai semua kandidat
+    shared_ptr<const ImportanceMap> importanceMap; // Peta kepentingan region (opsional)
+    LeafModel::Type leafModel;  // Leaf model yang dipakai semua kandidat
+    QuadTree::PartitionMode partitionMode; // Mode partisi yang dipakai semua kandidat
+    int splitGrid;              // Grid posisi potongan yang dipakai semua kandidat (0 = nonaktif)
+    vector<Candidate> candidates;
+    function<void(Candidate&, const QuadTree&, const unsigned char*)> treeHandler; // Dipanggil per kandidat (opsional)
+    int threadCount;
+    long long elapsedMs;
+
+public:
+    /**
+     * @brief Constructor untuk AutoTuner
+     * @param Statistik gambar yang dipakai bersama
+     * @param Jumlah worker thread (0 = jumlah core)
+     */
+    AutoTuner(shared_ptr<const ImageStatistics>, int = 0);
+
+    /**
+     * @brief Menambahkan satu kombinasi parameter untuk dievaluasi
+     * @param Metrik error
+     * @param Threshold error
+     * @param Ukuran blok minimum
+     */
+    void addCandidate(QuadTree::ErrorMetricType, double, int);
+
+    /**
+     * @brief Menetapkan peta kepentingan yang dipakai semua kandidat
+     * @param Peta kepentingan (nullptr untuk threshold seragam)
+     */
+    void setImportanceMap(shared_ptr<const ImportanceMap>);
+
+    /**
+     * @brief Menetapkan leaf model yang dipakai semua kandidat
+     * @param Tipe leaf model
+     */
+    void setLeafModel(LeafModel::Type);
+
+    /**
+     * @brief Menetapkan mode partisi yang dipakai semua kandidat
+     * @param Mode partisi
+     */
+    void setPartitionMode(QuadTree::PartitionMode);
+
+    /**
+     * @brief Menetapkan grid posisi potongan yang dipakai semua kandidat
+     * @param Ukuran grid (0 = nonaktif)
+     */
+    void setSplitGrid(int);
+
+    /**
+     * @brief Menetapkan fungsi yang menerima setiap tree kandidat setelah dievaluasi, dipanggil
+     *        dari worker thread sebelum tree dibuang (mis. untuk menyimpan output kandidat).
+     *        Fungsi juga menerima raster RGB interleaved yang sudah dipakai untuk PSNR/SSIM
+     * @param Fungsi penanganan tree
+     */
+    void setTreeHandler(const function<void(Candidate&, const QuadTree&, const unsigned char*)>&);
+
+    /**
+     * @brief Menambahkan grid default: 5 metrik x threshold x ukuran blok minimum
+     */
+    void addDefaultCandidates();
+
+    /**
+     * @brief Membangun dan mengevaluasi seluruh kandidat secara paralel
+     */
+    void run();
+
+    const vector<Candidate>& getCandidates() const;
+    long long getElapsedMs() const;
+
+    /**
+     * @brief Memilih kandidat terbaik untuk sebuah goal
+     * @param Jenis goal
+     * @param Nilai target goal
+     * @return Index kandidat terpilih, -1 jika tidak ada kandidat
+     */
+    int selectBest(GoalType, double) const;
+
+    /**
+     * @brief Menampilkan Pareto front ukuran terhadap PSNR/SSIM
+     */
+    void displayReport() const;
+
+    /**
+     * @brief Menulis hasil seluruh kandidat sebagai CSV, satu baris per kandidat
+     * @param Path file CSV
+     * @return true jika berhasil
+     */
+    bool writeCsv(const string&) const;
+
+    /**
+     * @brief Membaca goal dalam format "psnr:<dB>", "ssim:<0-1>", atau "size:<bytes>"
+     * @param String goal
+     * @param Jenis goal hasil parsing
+     * @param Nilai target hasil parsing
+     * @return true jika format valid
+     */
+    static bool parseGoal(const string&, GoalType&, double&);
+
+private:
+    /**
+     * @brief Membangun QuadTree untuk satu kandidat dan mengukur kualitasnya
+     * @param Kandidat yang dievaluasi
+     */
+    void evaluate(Candidate&) const;
+
+    /**
+     * @brief Menandai kandidat yang tidak didominasi kandidat lain
+     */
+    void markParetoFront();
+
+    /**
+     * @brief Ukuran kandidat untuk Pareto front dan goal ukuran
+     * @param Kandidat
+     * @return outputSize jika sudah diukur, selain itu estimatedSize
+     */
+    static size_t getSize(const Candidate&);
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "BandWriter.hpp"
+#include "Utils.hpp"
+#include <iostream>
+
+namespace {
+    void writeLittleEndian(vector<unsigned char>& out, uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+}
+
+BandWriter::BandWriter()
+    : format(PNG), width(0), height(0), rowsWritten(0), threadCount(0), adler(1) {
+}
+
+BandWriter::~BandWriter() {
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+bool BandWriter::supports(const string& ext) {
+    return ext == "png" || ext == "bmp" || ext == "ppm";
+}
+
+bool BandWriter::open(const string& path, int imageWidth, int imageHeight, int threads) {
+    string ext = Utils::getFileExtension(path);
+    if (!supports(ext)) {
+        std::cerr << "Error: Band output supports only .png, .bmp and .ppm" << std::endl;
+        return false;
+    }
+    if (imageWidth <= 0 || imageHeight <= 0) {
+        std::cerr << "Error: Invalid image size for band output" << std::endl;
+        return false;
+    }
+
+    format = ext == "png" ? PNG : ext == "bmp" ? BMP : PPM;
+    width = imageWidth;
+    height = imageHeight;
+    rowsWritten = 0;
+    threadCount = threads;
+    adler = 1;
+    previousRow.clear();
+
+    file.open(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    buffer.clear();
+    if (format == PNG) {
+        pngFormat.width = width;
+        pngFormat.height = height;
+        pngFormat.bitDepth = 8;
+        pngFormat.colorType = 2;                // RGB
+        pngFormat.rowBytes = static_cast<size_t>(width) * 3;
+        pngFormat.bytesPerPixel = 3;
+        PngWriter::writeHeaderChunks(pngFormat, vector<RGB>(), buffer);
+    } else if (format == BMP) {
+        // BMP top-down (tinggi negatif) agar baris dapat ditulis sesuai urutan band
+        uint32_t rowStride = (static_cast<uint32_t>(width) * 3 + 3) & ~3u;
+        uint32_t imageSize = rowStride * static_cast<uint32_t>(height);
+        buffer.push_back('B');
+        buffer.push_back('M');
+        writeLittleEndian(buffer, 54 + imageSize, 4);
+        writeLittleEndian(buffer, 0, 4);
+        writeLittleEndian(buffer, 54, 4);
+        writeLittleEndian(buffer, 40, 4);
+        writeLittleEndian(buffer, static_cast<uint32_t>(width), 4);
+        writeLittleEndian(buffer, static_cast<uint32_t>(-height), 4);
+        writeLittleEndian(buffer, 1, 2);            // Plane
+        writeLittleEndian(buffer, 24, 2);           // Bit per piksel
+        writeLittleEndian(buffer, 0, 4);            // Tanpa kompresi
+        writeLittleEndian(buffer, imageSize, 4);
+        writeLittleEndian(buffer, 2835, 4);         // 72 DPI
+        writeLittleEndian(buffer, 2835, 4);
+        writeLittleEndian(buffer, 0, 4);
+        writeLittleEndian(buffer, 0, 4);
+    } else {
+        string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+        buffer.assign(header.begin(), header.end());
+    }
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    return static_cast<bool>(file);
+}
+
+bool BandWriter::writeRows(const unsigned char* rows, int rowCount) {
+    if (!file.is_open() || !rows || rowCount <= 0 || rowsWritten + rowCount > height) {
+        std::cerr << "Error: Invalid band for output" << std::endl;
+        return false;
+    }
+
+    size_t rowBytes = static_cast<size_t>(width) * 3;
+    const unsigned char* output = rows;
+    size_t outputSize = rowBytes * rowCount;
+    if (format == PNG) {
+        bool lastRows = rowsWritten + rowCount == height;
+        buffer.clear();
+        PngWriter::writeDataChunks(pngFormat, rows, rowCount, previousRow.empty() ? nullptr : previousRow.data(),
+                                   lastRows, adler, buffer, threadCount);
+        if (lastRows) {
+            PngWriter::writeChunk(buffer, "IEND", nullptr, 0);
+        }
+        previousRow.assign(rows + rowBytes * (rowCount - 1), rows + rowBytes * rowCount);
+        output = buffer.data();
+        outputSize = buffer.size();
+    } else if (format == BMP) {
+        // Baris BMP berurutan BGR dan dipadding ke kelipatan 4 byte
+        size_t rowStride = (rowBytes + 3) & ~static_cast<size_t>(3);
+        buffer.assign(rowStride * rowCount, 0);
+        for (int y = 0; y < rowCount; y++) {
+            const unsigned char* source = rows + y * rowBytes;
+            unsigned char* target = &buffer[y * rowStride];
+            for (int x = 0; x < width; x++, source += 3, target += 3) {
+                target[0] = source[2];
+                target[1] = source[1];
+                target[2] = source[0];
+            }
+        }
+        output = buffer.data();
+        outputSize = buffer.size();
+    }
+
+    file.write(reinterpret_cast<const char*>(output), outputSize);
+    rowsWritten += rowCount;
+    return static_cast<bool>(file);
+}
+
+bool BandWriter::close() {
+    if (!file.is_open()) {
+        return false;
+    }
+    bool complete = rowsWritten == height;
+    file.close();
+    if (!complete) {
+        std::cerr << "Error: Band output closed after " << rowsWritten << " of " << height << " rows" << std::endl;
+        return false;
+    }
+    return !file.fail();
+}
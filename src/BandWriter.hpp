@@ -0,0 +1,72 @@
+#ifndef __BAND_WRITER__HPP__
+#define __BAND_WRITER__HPP__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "PngWriter.hpp"
+
+using namespace std;
+
+/**
+ * @class BandWriter
+ * @brief Penulis gambar RGB per band baris horizontal (PNG, BMP, PPM). Setiap band langsung
+ *        dikodekan dan ditulis ke file sebelum band berikutnya dirender, sehingga memori output
+ *        sebanding dengan lebar x tinggi band, bukan ukuran gambar
+ */
+class BandWriter {
+public:
+    enum Format {
+        PNG,
+        BMP,
+        PPM
+    };
+
+    BandWriter();
+    ~BandWriter();
+
+    /**
+     * @brief Apakah ekstensi file dapat ditulis per band
+     * @param Ekstensi file (huruf kecil, tanpa titik)
+     */
+    static bool supports(const string&);
+
+    /**
+     * @brief Membuka file output dan menulis header; format dipilih dari ekstensi
+     * @param Path file output
+     * @param Lebar gambar
+     * @param Tinggi gambar
+     * @param Jumlah worker thread untuk deflate PNG (0 = otomatis)
+     * @return true jika berhasil
+     */
+    bool open(const string&, int, int, int = 0);
+
+    /**
+     * @brief Menulis band berikutnya (baris berurutan dari atas ke bawah)
+     * @param Buffer RGB interleaved, width * 3 byte per baris tanpa padding
+     * @param Jumlah baris dalam band
+     * @return true jika berhasil
+     */
+    bool writeRows(const unsigned char*, int);
+
+    /**
+     * @brief Menutup file; gagal jika belum semua baris ditulis
+     * @return true jika file lengkap dan berhasil ditulis
+     */
+    bool close();
+
+private:
+    std::ofstream file;
+    Format format;
+    int width;
+    int height;
+    int rowsWritten;
+    int threadCount;
+    PngWriter::Format pngFormat;
+    uint32_t adler;                     // Adler-32 berjalan stream zlib PNG
+    vector<unsigned char> previousRow;  // Baris terakhir band sebelumnya (referensi filter PNG)
+    vector<unsigned char> buffer;       // Buffer encoding per band
+};
+
+#endif
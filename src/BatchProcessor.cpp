@@ -0,0 +1,271 @@
+#include "BatchProcessor.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <regex>
+#include <set>
+#include <streambuf>
+
+namespace {
+    // Streambuf yang membuang semua output tanpa mengubah state stream, aman dipakai banyak thread
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override {
+            return traits_type::not_eof(c);
+        }
+    };
+
+    // Format yang dapat dibaca loadImage; file lain di direktori input dilewati
+    bool isImageFile(const std::string& path) {
+        std::string ext = Utils::getFileExtension(path);
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+        static const char* const extensions[] = {
+            "png", "jpg", "jpeg", "bmp", "tga", "ppm", "pgm", "pnm", "qoi", "qtc", "qtp", "qti"
+        };
+        for (const char* known : extensions) {
+            if (ext == known) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string fileName(const std::string& path) {
+        size_t separator = path.find_last_of("/\\");
+        return separator == std::string::npos ? path : path.substr(separator + 1);
+    }
+
+    // Nama yang dihasilkan Utils::getDefaultOutputPath: <nama>_<m>_<t>_<b> atau <nama>_percentage_<c>
+    bool isBatchOutputName(const std::string& path) {
+        static const std::regex pattern("_([0-4]_[-+0-9.eE]+_[0-9]+|percentage_[-+0-9.eE]+)\\.[^.]*$");
+        return std::regex_search(fileName(path), pattern);
+    }
+}
+
+BatchProcessor::BatchProcessor(QuadTree::ErrorMetricType method, double _threshold, int _minBlockSize,
+                               double targetCompression)
+    : errorMetricType(method), threshold(_threshold), minBlockSize(_minBlockSize),
+      targetCompressionPercentage(targetCompression), wallTime(0) {
+}
+
+bool BatchProcessor::collectInputs(const string& spec, vector<string>& inputs) {
+    inputs.clear();
+    if (Utils::isDirectory(spec)) {
+        for (const string& path : Utils::listDirectory(spec)) {
+            if (isImageFile(path)) {
+                inputs.push_back(path);
+            }
+        }
+    } else if (spec.find_first_of("*?") != string::npos) {
+        // Wildcard hanya pada komponen terakhir path
+        size_t separator = spec.find_last_of("/\\");
+        string directory = separator == string::npos ? "." : spec.substr(0, separator);
+        string pattern = separator == string::npos ? spec : spec.substr(separator + 1);
+        for (const string& path : Utils::listDirectory(directory.empty() ? "/" : directory)) {
+            if (Utils::matchesWildcard(pattern, fileName(path))) {
+                inputs.push_back(separator == string::npos ? fileName(path) : path);
+            }
+        }
+    } else {
+        std::ifstream list(spec);
+        if (!list.good()) {
+            std::cerr << "Error: Batch input '" << spec << "' is not a directory, pattern or list file" << std::endl;
+            return false;
+        }
+        string line;
+        while (std::getline(list, line)) {
+            line.erase(0, line.find_first_not_of(" \t"));
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            if (!line.empty() && line[0] != '#') {
+                inputs.push_back(line);
+            }
+        }
+    }
+
+    if (inputs.empty()) {
+        std::cerr << "Error: No input images found for batch '" << spec << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void BatchProcessor::setConfigure(const function<void(ImageProcessor&)>& configureProcessor) {
+    configure = configureProcessor;
+}
+
+bool BatchProcessor::run(const vector<string>& requestedInputs, int threadCount) {
+    vector<string> inputs = filterInputs(requestedInputs, std::cerr);
+    if (inputs.empty()) {
+        std::cerr << "Error: No input images left after skipping batch outputs" << std::endl;
+        return false;
+    }
+    int workers = std::max(1, std::min(threadCount > 0 ? threadCount : Utils::getDefaultThreadCount(),
+                                       static_cast<int>(inputs.size())));
+    std::cout << "Batch: " << inputs.size() << " images, " << workers << " workers" << std::endl;
+
+    // Log per gambar dari ImageProcessor dibungkam selama batch; progres ditulis ke stream konsol asli
+    NullBuffer discard;
+    std::ostream console(std::cout.rdbuf(&discard));
+    std::mutex consoleMutex;
+    int completed = 0;
+
+    results.assign(inputs.size(), Result());
+    auto startTime = std::chrono::high_resolution_clock::now();
+    Utils::parallelFor(static_cast<int>(inputs.size()), workers, [&](int i) {
+        processImage(inputs[i], results[i]);
+
+        std::lock_guard<std::mutex> lock(consoleMutex);
+        completed++;
+        console << "[" << completed << "/" << inputs.size() << "] " << inputs[i];
+        if (results[i].success) {
+            console << " -> " << results[i].outputPath << " (" << results[i].timeMs << " ms)" << std::endl;
+        } else {
+            console << " failed (" << results[i].failedStage << ")" << std::endl;
+        }
+    });
+    auto endTime = std::chrono::high_resolution_clock::now();
+    wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    std::cout.rdbuf(console.rdbuf());
+
+    printSummary(std::cout);
+    return std::all_of(results.begin(), results.end(), [](const Result& result) { return result.success; });
+}
+
+const vector<BatchProcessor::Result>& BatchProcessor::getResults() const {
+    return results;
+}
+
+void BatchProcessor::processImage(const string& inputPath, Result& result) const {
+    result.inputPath = inputPath;
+    result.outputPath = Utils::getDefaultOutputPath(inputPath, errorMetricType, threshold, minBlockSize,
+                                                    targetCompressionPercentage);
+    result.success = false;
+    result.originalSize = result.compressedSize = 0;
+    result.nodeCount = result.maxDepth = 0;
+    result.timeMs = 0;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    // Exception (mis. bad_alloc) dicatat sebagai kegagalan tahap yang sedang berjalan agar tidak
+    // keluar dari worker dan menghentikan seluruh batch
+    string stage = "setup";
+    try {
+        ImageProcessor processor(inputPath, result.outputPath, minBlockSize, threshold, errorMetricType,
+                                 targetCompressionPercentage);
+        if (configure) {
+            configure(processor);
+        }
+        // Paralelisme ada di tingkat gambar, jadi setiap gambar memakai satu thread
+        processor.setThreadCount(1);
+
+        size_t separator = result.outputPath.find_last_of("/\\");
+        if (separator != string::npos && separator > 0) {
+            Utils::createDirectoryIfNotExists(result.outputPath.substr(0, separator));
+        }
+
+        stage = "load";
+        bool succeeded = processor.loadImage();
+        if (succeeded) {
+            stage = "compress";
+            succeeded = processor.compressImage();
+        }
+        if (succeeded) {
+            stage = "save";
+            succeeded = processor.saveCompressedImage();
+        }
+
+        if (!succeeded) {
+            result.failedStage = stage;
+        } else {
+            result.success = true;
+            result.originalSize = processor.getOriginalSize();
+            result.compressedSize = Utils::getFileSize(result.outputPath);
+            result.nodeCount = processor.getNodeCount();
+            result.maxDepth = processor.getMaxDepth();
+        }
+    } catch (const std::exception& error) {
+        result.success = false;
+        result.failedStage = stage + ": " + error.what();
+    } catch (...) {
+        result.success = false;
+        result.failedStage = stage + ": unknown error";
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    result.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+}
+
+// Output diletakkan di samping input jika path input tidak berisi "input", jadi hasil run sebelumnya
+// bisa ikut terkumpul; worker lain bisa sedang menulis file yang dibaca worker ini
+vector<string> BatchProcessor::filterInputs(const vector<string>& inputs, ostream& log) const {
+    vector<string> outputs;
+    set<string> outputSet;
+    for (const string& input : inputs) {
+        outputs.push_back(Utils::getDefaultOutputPath(input, errorMetricType, threshold, minBlockSize,
+                                                      targetCompressionPercentage));
+        outputSet.insert(outputs.back());
+    }
+
+    vector<string> accepted;
+    set<string> claimedOutputs;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (outputSet.count(inputs[i]) > 0 || isBatchOutputName(inputs[i])) {
+            log << "Skipping " << inputs[i] << ": it is a batch output file" << std::endl;
+        } else if (!claimedOutputs.insert(outputs[i]).second) {
+            log << "Skipping " << inputs[i] << ": another input already writes " << outputs[i] << std::endl;
+        } else {
+            accepted.push_back(inputs[i]);
+        }
+    }
+    return accepted;
+}
+
+void BatchProcessor::printSummary(ostream& out) const {
+    size_t nameWidth = 5;
+    for (const Result& result : results) {
+        nameWidth = std::max(nameWidth, std::min<size_t>(fileName(result.inputPath).size(), 40));
+    }
+
+    // State format stream pemanggil dikembalikan setelah tabel ditulis
+    std::ios savedState(nullptr);
+    savedState.copyfmt(out);
+
+    out << "\n=== Batch Results ===" << std::endl;
+    out << std::left << std::setw(nameWidth + 2) << "Image" << std::right
+        << std::setw(12) << "Original" << std::setw(12) << "Compressed" << std::setw(13) << "Compression"
+        << std::setw(9) << "Nodes" << std::setw(7) << "Depth" << std::setw(11) << "Time (ms)" << std::endl;
+
+    size_t totalOriginal = 0, totalCompressed = 0;
+    long long totalTime = 0;
+    int failures = 0;
+    for (const Result& result : results) {
+        out << std::left << std::setw(nameWidth + 2) << fileName(result.inputPath).substr(0, nameWidth) << std::right;
+        if (!result.success) {
+            out << "failed (" << result.failedStage << ")" << std::endl;
+            failures++;
+            continue;
+        }
+        double compression = result.originalSize > 0
+            ? 100.0 * (1.0 - static_cast<double>(result.compressedSize) / result.originalSize) : 0.0;
+        out << std::setw(12) << result.originalSize << std::setw(12) << result.compressedSize
+            << std::setw(12) << std::fixed << std::setprecision(2) << compression << "%"
+            << std::setw(9) << result.nodeCount << std::setw(7) << result.maxDepth
+            << std::setw(11) << result.timeMs << std::endl;
+        totalOriginal += result.originalSize;
+        totalCompressed += result.compressedSize;
+        totalTime += result.timeMs;
+    }
+
+    double totalCompression = totalOriginal > 0
+        ? 100.0 * (1.0 - static_cast<double>(totalCompressed) / totalOriginal) : 0.0;
+    out << std::left << std::setw(nameWidth + 2) << "Total" << std::right
+        << std::setw(12) << totalOriginal << std::setw(12) << totalCompressed
+        << std::setw(12) << std::fixed << std::setprecision(2) << totalCompression << "%"
+        << std::setw(27) << totalTime << std::endl;
+    out << (results.size() - failures) << " of " << results.size() << " images compressed in "
+        << wallTime.count() << " ms wall time" << std::endl;
+    out.copyfmt(savedState);
+}
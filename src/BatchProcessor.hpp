@@ -0,0 +1,96 @@
+#ifndef __BATCH_PROCESSOR__HPP__
+#define __BATCH_PROCESSOR__HPP__
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "ImageProcessor.hpp"
+
+using namespace std;
+
+/**
+ * @class BatchProcessor
+ * @brief Kompresi banyak gambar dalam satu proses dengan pool worker berukuran tetap. Setiap worker
+ *        memproses satu gambar utuh (load, kompresi, simpan) dengan satu thread, sehingga gambar
+ *        berjalan paralel tanpa biaya startup proses per gambar. Output memakai penamaan default
+ *        Utils::getDefaultOutputPath dan ringkasan ditampilkan dalam satu tabel di akhir
+ */
+class BatchProcessor {
+public:
+    // Hasil kompresi satu gambar
+    struct Result {
+        string inputPath;
+        string outputPath;
+        bool success;
+        string failedStage;     // Tahap yang gagal (load, compress, save), beserta pesan exception jika ada
+        size_t originalSize;
+        size_t compressedSize;
+        int nodeCount;
+        int maxDepth;
+        long long timeMs;
+    };
+
+    /**
+     * @brief Constructor untuk BatchProcessor
+     * @param Jenis metrik error
+     * @param Threshold error
+     * @param Ukuran blok minimum
+     * @param Target persentase kompresi (0 untuk menonaktifkan)
+     */
+    BatchProcessor(QuadTree::ErrorMetricType, double, int, double = 0.0);
+
+    /**
+     * @brief Mengumpulkan daftar gambar input dari direktori, pola wildcard pada nama file,
+     *        atau file daftar berisi satu path per baris (baris kosong dan # diabaikan)
+     * @param Spesifikasi input
+     * @param Daftar path gambar output
+     * @return true jika minimal satu gambar ditemukan
+     */
+    static bool collectInputs(const string&, vector<string>&);
+
+    /**
+     * @brief Menetapkan fungsi yang menerapkan opsi kompresi ke setiap ImageProcessor
+     * @param Fungsi konfigurasi
+     */
+    void setConfigure(const function<void(ImageProcessor&)>&);
+
+    /**
+     * @brief Mengompres semua gambar dan menampilkan tabel ringkasan
+     * @param Daftar path gambar input
+     * @param Jumlah worker (0 = jumlah core)
+     * @return true jika semua gambar berhasil
+     */
+    bool run(const vector<string>&, int = 0);
+
+    const vector<Result>& getResults() const;
+
+private:
+    QuadTree::ErrorMetricType errorMetricType;
+    double threshold;
+    int minBlockSize;
+    double targetCompressionPercentage;
+    function<void(ImageProcessor&)> configure;
+    vector<Result> results;
+    chrono::milliseconds wallTime;
+
+    /**
+     * @brief Memproses satu gambar; log ImageProcessor sudah dibungkam oleh run
+     * @param Path gambar input
+     * @param Hasil yang diisi
+     */
+    void processImage(const string&, Result&) const;
+
+    /**
+     * @brief Membuang input yang merupakan output batch (path output input lain atau nama
+     *        berpola _<m>_<t>_<b>) dan input yang menghasilkan path output yang sama
+     * @param Daftar path gambar input
+     * @param Stream untuk melaporkan input yang dilewati
+     * @return Daftar input yang aman diproses bersamaan
+     */
+    vector<string> filterInputs(const vector<string>&, ostream&) const;
+
+    void printSummary(ostream&) const;
+};
+
+#endif
@@ -46,23 +46,43 @@ bool Block::operator==(const Block& other) const {
 }
 
 Block Block::getQuadrant(int quadrant) const {
-    int halfWidth = width / 2;
-    int halfHeight = height / 2;
+    // Kuadran kanan/bawah mengambil sisa piksel agar dimensi ganjil tetap tertutup
+    return getQuadrant(quadrant, width / 2, height / 2);
+}
+
+Block Block::getQuadrant(int quadrant, int splitX, int splitY) const {
+    int restWidth = width - splitX;
+    int restHeight = height - splitY;
     
     switch (quadrant) {
         case 0: // Top-left
-            return Block(x, y, halfWidth, halfHeight);
+            return Block(x, y, splitX, splitY);
         case 1: // Top-right
-            return Block(x + halfWidth, y, halfWidth, halfHeight);
+            return Block(x + splitX, y, restWidth, splitY);
         case 2: // Bottom-left
-            return Block(x, y + halfHeight, halfWidth, halfHeight);
+            return Block(x, y + splitY, splitX, restHeight);
         case 3: // Bottom-right
-            return Block(x + halfWidth, y + halfHeight, halfWidth, halfHeight);
+            return Block(x + splitX, y + splitY, restWidth, restHeight);
         default:
             return Block(); // Default empty block
     }
 }
 
+Block Block::scaled(int sourceWidth, int sourceHeight, int targetWidth, int targetHeight) const {
+    // Tepi dibulatkan ke piksel tujuan terdekat sehingga setiap piksel tujuan mengambil leaf di titik tengahnya
+    auto scale = [](int value, int source, int target) {
+        return static_cast<int>((2LL * value * target + source) / (2LL * source));
+    };
+    int left = scale(x, sourceWidth, targetWidth);
+    int top = scale(y, sourceHeight, targetHeight);
+    int right = scale(x + width, sourceWidth, targetWidth);
+    int bottom = scale(y + height, sourceHeight, targetHeight);
+    return Block(left, top, right - left, bottom - top);
+}
+
+long long Block::getArea() const {
+    return static_cast<long long>(width) * height;
+}
 
 bool Block::contains(int pointX, int pointY) const {
     return pointX >= x && pointX < x + width && 
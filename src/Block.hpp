@@ -42,6 +42,31 @@ public:
      * @return Block baru untuk kuadran yang diminta
      */
     Block getQuadrant(int) const;
+
+    /**
+     * @brief Mendapatkan kuadran untuk titik potong sembarang
+     * @param Nomor kuadran (0=top-left, 1=top-right, 2=bottom-left, 3=bottom-right)
+     * @param Offset garis potong vertikal dari x (width = tanpa potongan vertikal)
+     * @param Offset garis potong horizontal dari y (height = tanpa potongan horizontal)
+     * @return Block baru untuk kuadran yang diminta (dapat berukuran nol)
+     */
+    Block getQuadrant(int, int, int) const;
+
+    /**
+     * @brief Memetakan persegi ke grid gambar berukuran lain; tepi dipetakan dengan fungsi yang sama
+     *        sehingga persegi yang bersebelahan tetap menutup tanpa celah (dapat berukuran nol)
+     * @param Lebar gambar asal
+     * @param Tinggi gambar asal
+     * @param Lebar gambar tujuan
+     * @param Tinggi gambar tujuan
+     * @return Block dalam koordinat gambar tujuan
+     */
+    Block scaled(int, int, int, int) const;
+
+    /**
+     * @brief Luas persegi dalam piksel
+     */
+    long long getArea() const;
     /**
      * @brief Memeriksa apakah sebuah titik berada di dalam persegi
      * @param Koordinat x dari titik
@@ -0,0 +1,501 @@
+#include "Deflate.hpp"
+#include <algorithm>
+#include <queue>
+
+namespace {
+    const int HASH_BITS = 15;
+    const int HASH_SIZE = 1 << HASH_BITS;
+    const int WINDOW_MASK = Deflate::WINDOW_SIZE - 1;
+    const int MAX_CHAIN = 16;       // Kandidat hash chain yang diperiksa per posisi
+    const int LONG_MATCH = 32;      // Match sepanjang ini diterima tanpa mencari lebih jauh
+    const uint32_t ADLER_BASE = 65521;
+    const size_t ADLER_NMAX = 5552;
+
+    const int LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    const int LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                   3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+    const int DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                    8193, 12289, 16385, 24577 };
+    const int DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                     7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+    const int CODE_LENGTH_ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    inline uint32_t hashAt(const unsigned char* p) {
+        return ((static_cast<uint32_t>(p[0]) << 10) ^ (static_cast<uint32_t>(p[1]) << 5) ^ p[2]) & (HASH_SIZE - 1);
+    }
+
+    inline int matchLength(const unsigned char* a, const unsigned char* b, int maxLength) {
+        int length = 0;
+        while (length < maxLength && a[length] == b[length]) {
+            length++;
+        }
+        return length;
+    }
+
+    // Elemen code length setelah run-length encoding (simbol 16/17/18 membawa extra bits)
+    struct CodeLengthSymbol {
+        uint8_t symbol;
+        uint8_t extra;
+    };
+
+    void encodeCodeLengths(const uint8_t* lengths, int count, vector<CodeLengthSymbol>& out) {
+        for (int i = 0; i < count;) {
+            int run = 1;
+            while (i + run < count && lengths[i + run] == lengths[i]) {
+                run++;
+            }
+            if (lengths[i] == 0) {
+                int remaining = run;
+                while (remaining >= 11) {
+                    int n = std::min(remaining, 138);
+                    out.push_back({ 18, static_cast<uint8_t>(n - 11) });
+                    remaining -= n;
+                }
+                if (remaining >= 3) {
+                    out.push_back({ 17, static_cast<uint8_t>(remaining - 3) });
+                    remaining = 0;
+                }
+                while (remaining-- > 0) {
+                    out.push_back({ 0, 0 });
+                }
+            } else {
+                out.push_back({ lengths[i], 0 });
+                int remaining = run - 1;
+                while (remaining >= 3) {
+                    int n = std::min(remaining, 6);
+                    out.push_back({ 16, static_cast<uint8_t>(n - 3) });
+                    remaining -= n;
+                }
+                while (remaining-- > 0) {
+                    out.push_back({ lengths[i], 0 });
+                }
+            }
+            i += run;
+        }
+    }
+
+    int codeLengthExtraBits(int symbol) {
+        return symbol == 16 ? 2 : symbol == 17 ? 3 : symbol == 18 ? 7 : 0;
+    }
+}
+
+// ==================== BitWriter ====================
+
+Deflate::BitWriter::BitWriter(vector<unsigned char>& _out)
+    : out(_out), buffer(0), count(0) {
+}
+
+void Deflate::BitWriter::write(uint32_t bits, int numBits) {
+    buffer |= static_cast<uint64_t>(bits) << count;
+    count += numBits;
+    while (count >= 8) {
+        out.push_back(static_cast<unsigned char>(buffer));
+        buffer >>= 8;
+        count -= 8;
+    }
+}
+
+void Deflate::BitWriter::align() {
+    if (count > 0) {
+        out.push_back(static_cast<unsigned char>(buffer));
+    }
+    buffer = 0;
+    count = 0;
+}
+
+// ==================== Deflate ====================
+
+void Deflate::compress(const unsigned char* data, size_t size, bool final, vector<unsigned char>& out) {
+    BitWriter writer(out);
+    vector<int32_t> head(HASH_SIZE, -1);
+    vector<int32_t> previous(WINDOW_SIZE, -1);
+    vector<Token> tokens;
+    tokens.reserve(TOKENS_PER_BLOCK);
+
+    auto insert = [&](size_t position) {
+        if (position + MIN_MATCH <= size) {
+            uint32_t hash = hashAt(data + position);
+            previous[position & WINDOW_MASK] = head[hash];
+            head[hash] = static_cast<int32_t>(position);
+        }
+    };
+
+    size_t blockStart = 0;
+    size_t position = 0;
+    while (position < size) {
+        int maxLength = static_cast<int>(std::min<size_t>(MAX_MATCH, size - position));
+        int bestLength = 0;
+        int bestDistance = 0;
+
+        if (maxLength >= MIN_MATCH) {
+            // Jalan pintas run: baris hasil filter quadtree didominasi byte berulang
+            if (position > 0 && data[position] == data[position - 1]) {
+                bestLength = matchLength(data + position, data + position - 1, maxLength);
+                bestDistance = 1;
+            }
+            if (bestLength < LONG_MATCH && bestLength < maxLength) {
+                int32_t candidate = head[hashAt(data + position)];
+                for (int chain = 0; chain < MAX_CHAIN && candidate >= 0; chain++) {
+                    size_t distance = position - candidate;
+                    if (distance > static_cast<size_t>(WINDOW_SIZE)) {
+                        break;
+                    }
+                    const unsigned char* match = data + candidate;
+                    if (match[bestLength] == data[position + bestLength] || bestLength == 0) {
+                        int length = matchLength(data + position, match, maxLength);
+                        if (length > bestLength) {
+                            bestLength = length;
+                            bestDistance = static_cast<int>(distance);
+                            if (length >= LONG_MATCH || length == maxLength) {
+                                break;
+                            }
+                        }
+                    }
+                    int32_t next = previous[candidate & WINDOW_MASK];
+                    if (next >= candidate) {
+                        break;
+                    }
+                    candidate = next;
+                }
+            }
+        }
+
+        if (bestLength >= MIN_MATCH) {
+            tokens.push_back({ static_cast<uint16_t>(bestLength), static_cast<uint16_t>(bestDistance) });
+            // Posisi di dalam match panjang tidak dimasukkan ke hash (cukup posisi awalnya)
+            int inserted = bestLength < LONG_MATCH ? bestLength : 1;
+            for (int i = 0; i < inserted; i++) {
+                insert(position + i);
+            }
+            position += bestLength;
+        } else {
+            tokens.push_back({ data[position], 0 });
+            insert(position);
+            position++;
+        }
+
+        // Blok baru setiap TOKENS_PER_BLOCK token agar kode Huffman mengikuti statistik lokal
+        if (tokens.size() >= TOKENS_PER_BLOCK && position < size) {
+            writeBlock(writer, tokens, data + blockStart, position - blockStart, false);
+            tokens.clear();
+            blockStart = position;
+        }
+    }
+    writeBlock(writer, tokens, data + blockStart, position - blockStart, final);
+
+    if (!final) {
+        // Sync flush: blok stored kosong membuat output byte-aligned
+        writeStored(writer, nullptr, 0, false);
+    }
+    writer.align();
+}
+
+void Deflate::writeBlock(BitWriter& writer, const vector<Token>& tokens,
+                         const unsigned char* raw, size_t rawSize, bool final) {
+    uint32_t literalFrequency[LITERAL_CODES] = { 0 };
+    uint32_t distanceFrequency[DISTANCE_CODES] = { 0 };
+    for (const Token& token : tokens) {
+        if (token.distance == 0) {
+            literalFrequency[token.value]++;
+        } else {
+            literalFrequency[257 + lengthCode(token.value)]++;
+            distanceFrequency[distanceCode(token.distance)]++;
+        }
+    }
+    literalFrequency[256] = 1;
+
+    // Setiap tree minimal memiliki dua kode agar selalu lengkap
+    if (std::count_if(literalFrequency, literalFrequency + LITERAL_CODES, [](uint32_t f) { return f > 0; }) < 2) {
+        literalFrequency[literalFrequency[0] ? 1 : 0] = 1;
+    }
+    int usedDistances = static_cast<int>(std::count_if(distanceFrequency, distanceFrequency + DISTANCE_CODES,
+                                                       [](uint32_t f) { return f > 0; }));
+    if (usedDistances < 2) {
+        distanceFrequency[distanceFrequency[0] ? 1 : 0] = 1;
+        if (usedDistances == 0) {
+            distanceFrequency[1] = 1;
+        }
+    }
+
+    uint8_t literalLengths[LITERAL_CODES];
+    uint8_t distanceLengths[DISTANCE_CODES];
+    buildLengths(literalFrequency, LITERAL_CODES, 15, literalLengths);
+    buildLengths(distanceFrequency, DISTANCE_CODES, 15, distanceLengths);
+
+    int literalCount = LITERAL_CODES;
+    while (literalCount > 257 && literalLengths[literalCount - 1] == 0) {
+        literalCount--;
+    }
+    int distanceCount = DISTANCE_CODES;
+    while (distanceCount > 1 && distanceLengths[distanceCount - 1] == 0) {
+        distanceCount--;
+    }
+
+    uint8_t allLengths[LITERAL_CODES + DISTANCE_CODES];
+    std::copy(literalLengths, literalLengths + literalCount, allLengths);
+    std::copy(distanceLengths, distanceLengths + distanceCount, allLengths + literalCount);
+    vector<CodeLengthSymbol> codeLengthSymbols;
+    encodeCodeLengths(allLengths, literalCount + distanceCount, codeLengthSymbols);
+
+    uint32_t codeLengthFrequency[CODE_LENGTH_CODES] = { 0 };
+    for (const CodeLengthSymbol& item : codeLengthSymbols) {
+        codeLengthFrequency[item.symbol]++;
+    }
+    if (std::count_if(codeLengthFrequency, codeLengthFrequency + CODE_LENGTH_CODES, [](uint32_t f) { return f > 0; }) < 2) {
+        codeLengthFrequency[codeLengthFrequency[0] ? 1 : 0] = 1;
+    }
+    uint8_t codeLengthLengths[CODE_LENGTH_CODES];
+    buildLengths(codeLengthFrequency, CODE_LENGTH_CODES, 7, codeLengthLengths);
+    int codeLengthCount = CODE_LENGTH_CODES;
+    while (codeLengthCount > 4 && codeLengthLengths[CODE_LENGTH_ORDER[codeLengthCount - 1]] == 0) {
+        codeLengthCount--;
+    }
+
+    // Bandingkan ukuran blok dinamis dengan blok stored
+    uint64_t dynamicBits = 3 + 14 + 3 * static_cast<uint64_t>(codeLengthCount);
+    for (const CodeLengthSymbol& item : codeLengthSymbols) {
+        dynamicBits += codeLengthLengths[item.symbol] + codeLengthExtraBits(item.symbol);
+    }
+    for (int s = 0; s < LITERAL_CODES; s++) {
+        dynamicBits += static_cast<uint64_t>(literalFrequency[s]) * literalLengths[s];
+    }
+    for (int c = 0; c < 29; c++) {
+        dynamicBits += static_cast<uint64_t>(literalFrequency[257 + c]) * LENGTH_EXTRA[c];
+    }
+    for (int c = 0; c < DISTANCE_CODES; c++) {
+        dynamicBits += static_cast<uint64_t>(distanceFrequency[c]) * (distanceLengths[c] + DISTANCE_EXTRA[c]);
+    }
+    uint64_t storedBits = (static_cast<uint64_t>(rawSize) + 5 * (rawSize / 65535 + 1)) * 8 + 8;
+    if (storedBits < dynamicBits) {
+        writeStored(writer, raw, rawSize, final);
+        return;
+    }
+
+    uint16_t literalCodes[LITERAL_CODES];
+    uint16_t distanceCodes[DISTANCE_CODES];
+    uint16_t codeLengthCodes[CODE_LENGTH_CODES];
+    buildCodes(literalLengths, LITERAL_CODES, literalCodes);
+    buildCodes(distanceLengths, DISTANCE_CODES, distanceCodes);
+    buildCodes(codeLengthLengths, CODE_LENGTH_CODES, codeLengthCodes);
+
+    writer.write(final ? 1 : 0, 1);
+    writer.write(2, 2);
+    writer.write(literalCount - 257, 5);
+    writer.write(distanceCount - 1, 5);
+    writer.write(codeLengthCount - 4, 4);
+    for (int i = 0; i < codeLengthCount; i++) {
+        writer.write(codeLengthLengths[CODE_LENGTH_ORDER[i]], 3);
+    }
+    for (const CodeLengthSymbol& item : codeLengthSymbols) {
+        writer.write(codeLengthCodes[item.symbol], codeLengthLengths[item.symbol]);
+        int extraBits = codeLengthExtraBits(item.symbol);
+        if (extraBits > 0) {
+            writer.write(item.extra, extraBits);
+        }
+    }
+
+    for (const Token& token : tokens) {
+        if (token.distance == 0) {
+            writer.write(literalCodes[token.value], literalLengths[token.value]);
+            continue;
+        }
+        int length = lengthCode(token.value);
+        writer.write(literalCodes[257 + length], literalLengths[257 + length]);
+        if (LENGTH_EXTRA[length] > 0) {
+            writer.write(token.value - LENGTH_BASE[length], LENGTH_EXTRA[length]);
+        }
+        int distance = distanceCode(token.distance);
+        writer.write(distanceCodes[distance], distanceLengths[distance]);
+        if (DISTANCE_EXTRA[distance] > 0) {
+            writer.write(token.distance - DISTANCE_BASE[distance], DISTANCE_EXTRA[distance]);
+        }
+    }
+    writer.write(literalCodes[256], literalLengths[256]);
+}
+
+void Deflate::writeStored(BitWriter& writer, const unsigned char* raw, size_t rawSize, bool final) {
+    size_t offset = 0;
+    do {
+        size_t length = std::min<size_t>(rawSize - offset, 65535);
+        bool last = offset + length == rawSize;
+        writer.write(final && last ? 1 : 0, 1);
+        writer.write(0, 2);
+        writer.align();
+        writer.write(static_cast<uint32_t>(length), 16);
+        writer.write(static_cast<uint32_t>(~length & 0xFFFF), 16);
+        writer.out.insert(writer.out.end(), raw + offset, raw + offset + length);
+        offset += length;
+    } while (offset < rawSize);
+}
+
+// Huffman biasa; jika terlalu dalam, frekuensi diratakan lalu dibangun ulang
+void Deflate::buildLengths(const uint32_t* frequency, int count, int maxBits, uint8_t* lengths) {
+    vector<uint32_t> weights(frequency, frequency + count);
+    while (true) {
+        std::fill(lengths, lengths + count, 0);
+        typedef std::pair<uint64_t, int> Item;
+        std::priority_queue<Item, vector<Item>, std::greater<Item>> queue;
+        vector<int> parent;
+        for (int s = 0; s < count; s++) {
+            if (weights[s] > 0) {
+                queue.push(Item(weights[s], static_cast<int>(parent.size())));
+                parent.push_back(-1);
+            }
+        }
+        int leafCount = static_cast<int>(parent.size());
+        while (queue.size() > 1) {
+            Item a = queue.top();
+            queue.pop();
+            Item b = queue.top();
+            queue.pop();
+            int node = static_cast<int>(parent.size());
+            parent.push_back(-1);
+            parent[a.second] = node;
+            parent[b.second] = node;
+            queue.push(Item(a.first + b.first, node));
+        }
+
+        // Kedalaman node dihitung dari root (node internal selalu dibuat setelah anaknya)
+        vector<int> depth(parent.size(), 0);
+        for (int node = static_cast<int>(parent.size()) - 2; node >= 0; node--) {
+            depth[node] = depth[parent[node]] + 1;
+        }
+        int maxDepth = 0;
+        for (int s = 0, leaf = 0; s < count; s++) {
+            if (weights[s] > 0) {
+                lengths[s] = static_cast<uint8_t>(depth[leaf]);
+                maxDepth = std::max(maxDepth, depth[leaf]);
+                leaf++;
+            }
+        }
+        if (leafCount == 1) {
+            for (int s = 0; s < count; s++) {
+                if (weights[s] > 0) {
+                    lengths[s] = 1;
+                }
+            }
+            return;
+        }
+        if (maxDepth <= maxBits) {
+            return;
+        }
+        for (uint32_t& weight : weights) {
+            if (weight > 0) {
+                weight = std::max<uint32_t>(1, weight >> 1);
+            }
+        }
+    }
+}
+
+void Deflate::buildCodes(const uint8_t* lengths, int count, uint16_t* codes) {
+    int lengthCount[16] = { 0 };
+    for (int s = 0; s < count; s++) {
+        lengthCount[lengths[s]]++;
+    }
+    lengthCount[0] = 0;
+    int nextCode[16] = { 0 };
+    int code = 0;
+    for (int bits = 1; bits < 16; bits++) {
+        code = (code + lengthCount[bits - 1]) << 1;
+        nextCode[bits] = code;
+    }
+    for (int s = 0; s < count; s++) {
+        int length = lengths[s];
+        codes[s] = 0;
+        if (length == 0) {
+            continue;
+        }
+        int value = nextCode[length]++;
+        int reversed = 0;
+        for (int i = 0; i < length; i++) {
+            reversed = (reversed << 1) | ((value >> i) & 1);
+        }
+        codes[s] = static_cast<uint16_t>(reversed);
+    }
+}
+
+int Deflate::lengthCode(int length) {
+    // Inisialisasi static lokal aman dipanggil dari beberapa thread sekaligus
+    static const vector<uint8_t> table = []() {
+        vector<uint8_t> codes(MAX_MATCH + 1, 0);
+        for (int c = 0; c < 29; c++) {
+            int end = c < 28 ? LENGTH_BASE[c + 1] : MAX_MATCH + 1;
+            for (int l = LENGTH_BASE[c]; l < end; l++) {
+                codes[l] = static_cast<uint8_t>(c);
+            }
+        }
+        return codes;
+    }();
+    return table[length];
+}
+
+int Deflate::distanceCode(int distance) {
+    return static_cast<int>(std::upper_bound(DISTANCE_BASE, DISTANCE_BASE + DISTANCE_CODES, distance)
+                            - DISTANCE_BASE) - 1;
+}
+
+uint32_t Deflate::adler32(const unsigned char* data, size_t size, uint32_t adler) {
+    uint32_t a = adler & 0xFFFF;
+    uint32_t b = adler >> 16;
+    while (size > 0) {
+        size_t block = std::min(size, ADLER_NMAX);
+        size -= block;
+        for (size_t i = 0; i < block; i++) {
+            a += data[i];
+            b += a;
+        }
+        data += block;
+        a %= ADLER_BASE;
+        b %= ADLER_BASE;
+    }
+    return (b << 16) | a;
+}
+
+uint32_t Deflate::adler32Combine(uint32_t first, uint32_t second, size_t secondLength) {
+    uint32_t remainder = static_cast<uint32_t>(secondLength % ADLER_BASE);
+    uint32_t a = first & 0xFFFF;
+    uint32_t b = static_cast<uint32_t>((static_cast<uint64_t>(remainder) * a) % ADLER_BASE);
+    a += (second & 0xFFFF) + ADLER_BASE - 1;
+    b += (first >> 16) + (second >> 16) + ADLER_BASE - remainder;
+    if (a >= ADLER_BASE) a -= ADLER_BASE;
+    if (a >= ADLER_BASE) a -= ADLER_BASE;
+    if (b >= 2 * ADLER_BASE) b -= 2 * ADLER_BASE;
+    if (b >= ADLER_BASE) b -= ADLER_BASE;
+    return (b << 16) | a;
+}
+
+uint32_t Deflate::crc32(const unsigned char* data, size_t size, uint32_t crc) {
+    static const vector<uint32_t> table = []() {
+        vector<uint32_t> entries(256);
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[n] = c;
+        }
+        return entries;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void Deflate::gzip(const unsigned char* data, size_t size, vector<unsigned char>& out) {
+    // Header: magic, metode deflate, tanpa flag dan waktu, OS tidak diketahui
+    const unsigned char header[10] = { 0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF };
+    out.assign(header, header + 10);
+    compress(data, size, true, out);
+
+    uint32_t trailer[2] = { crc32(data, size), static_cast<uint32_t>(size) };
+    for (uint32_t value : trailer) {
+        for (int i = 0; i < 4; i++) {
+            out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef __DEFLATE__HPP__
+#define __DEFLATE__HPP__
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class Deflate
+ * @brief Kompresor deflate (RFC 1951) cepat untuk data hasil filter PNG gambar quadtree.
+ *        LZ77 dengan hash chain pendek, jalan pintas untuk run (jarak 1) dan match panjang,
+ *        serta blok Huffman dinamis (fallback ke blok stored jika lebih kecil)
+ */
+class Deflate {
+public:
+    static const int WINDOW_SIZE = 32768;
+    static const int MIN_MATCH = 3;
+    static const int MAX_MATCH = 258;
+
+    /**
+     * @brief Mengompres data menjadi rangkaian blok deflate mentah
+     * @param Data input
+     * @param Ukuran data
+     * @param true jika ini segmen terakhir stream (blok terakhir diberi BFINAL); jika tidak,
+     *        output diakhiri sync flush sehingga segmen berikutnya dapat disambung langsung
+     * @param Buffer output (data ditambahkan di akhir)
+     */
+    static void compress(const unsigned char*, size_t, bool, vector<unsigned char>&);
+
+    /**
+     * @brief Checksum Adler-32 (trailer zlib)
+     * @param Data
+     * @param Ukuran data
+     * @param Nilai awal (1 untuk stream baru)
+     */
+    static uint32_t adler32(const unsigned char*, size_t, uint32_t = 1);
+
+    /**
+     * @brief Menggabungkan Adler-32 dua bagian data yang berurutan
+     * @param Adler-32 bagian pertama
+     * @param Adler-32 bagian kedua
+     * @param Panjang bagian kedua
+     */
+    static uint32_t adler32Combine(uint32_t, uint32_t, size_t);
+
+    /**
+     * @brief CRC-32 (polinom 0xEDB88320, dipakai chunk PNG dan trailer gzip)
+     * @param Data
+     * @param Ukuran data
+     * @param Nilai CRC sebelumnya (0 untuk data baru)
+     */
+    static uint32_t crc32(const unsigned char*, size_t, uint32_t = 0);
+
+    /**
+     * @brief Membungkus data dalam format gzip (RFC 1952)
+     * @param Data
+     * @param Ukuran data
+     * @param Buffer output
+     */
+    static void gzip(const unsigned char*, size_t, vector<unsigned char>&);
+
+private:
+    static const int LITERAL_CODES = 286;
+    static const int DISTANCE_CODES = 30;
+    static const int CODE_LENGTH_CODES = 19;
+    static const size_t TOKENS_PER_BLOCK = 1 << 15;
+
+    // Hasil LZ77: literal (distance = 0) atau pasangan panjang/jarak
+    struct Token {
+        uint16_t value;     // Byte literal atau panjang match
+        uint16_t distance;
+    };
+
+    // Penulis bit LSB-first sesuai urutan bit deflate
+    struct BitWriter {
+        vector<unsigned char>& out;
+        uint64_t buffer;
+        int count;
+        explicit BitWriter(vector<unsigned char>&);
+        void write(uint32_t, int);
+        void align();
+    };
+
+    /**
+     * @brief Menulis satu blok (dinamis atau stored, mana yang lebih kecil)
+     */
+    static void writeBlock(BitWriter&, const vector<Token>&, const unsigned char*, size_t, bool);
+
+    static void writeStored(BitWriter&, const unsigned char*, size_t, bool);
+
+    /**
+     * @brief Panjang kode Huffman dengan batas panjang maksimum
+     * @param Frekuensi simbol
+     * @param Jumlah simbol
+     * @param Panjang kode maksimum
+     * @param Output panjang kode
+     */
+    static void buildLengths(const uint32_t*, int, int, uint8_t*);
+
+    /**
+     * @brief Kode kanonik dari panjang kode, sudah dibalik untuk penulisan LSB-first
+     */
+    static void buildCodes(const uint8_t*, int, uint16_t*);
+
+    static int lengthCode(int);
+    static int distanceCode(int);
+};
+
+#endif
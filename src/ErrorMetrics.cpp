@@ -270,7 +270,6 @@ double ErrorMetrics::calculateChannelSSIM(const vector<vector<RGB>>& image,
     
     // Kita sudah tahu nilai rata-rata dari original region (avgVal)
     double mu1 = static_cast<double>(avgVal);
-    double mu2 = mu1;  // Untuk region yang sudah dikompresi, nilai semua piksel = avgVal
     
     // Hitung variance untuk region asli
     double sigma1_sq = 0.0;
@@ -293,6 +292,13 @@ double ErrorMetrics::calculateChannelSSIM(const vector<vector<RGB>>& image,
         sigma1_sq /= count;
     }
     
+    return ssimFromVariance(mu1, sigma1_sq);
+}
+
+// Menghitung error SSIM satu channel dari rata-rata dan variance region
+double ErrorMetrics::ssimFromVariance(double mu1, double sigma1_sq) {
+    double mu2 = mu1;  // Untuk region yang sudah dikompresi, nilai semua piksel = avgVal
+    
     // Untuk region terkompresi, semua piksel sama, jadi variance = 0
     double sigma2_sq = 0.0;
     
@@ -310,4 +316,231 @@ double ErrorMetrics::calculateChannelSSIM(const vector<vector<RGB>>& image,
     // SSIM seharusnya berada di range [-1, 1], nilai lebih tinggi = lebih mirip
     // Kita ingin mengubahnya menjadi error metric (0 = mirip, nilai tinggi = beda)
     return 1.0 - ssim;
+}
+
+// Menghitung variance RGB dalam O(1) dari summed-area table
+double ErrorMetrics::calculateVariance(const ImageStatistics& stats, 
+                                       const Block& region, 
+                                       const RGB& avgColor) {
+    long long count = stats.getPixelCount(region);
+    if (count == 0) {
+        return 0.0;
+    }
+    
+    double varR = static_cast<double>(stats.getChannelSquaredError(region, 0, avgColor.getRed())) / count;
+    double varG = static_cast<double>(stats.getChannelSquaredError(region, 1, avgColor.getGreen())) / count;
+    double varB = static_cast<double>(stats.getChannelSquaredError(region, 2, avgColor.getBlue())) / count;
+    
+    return (varR + varG + varB) / 3.0;
+}
+
+// Menghitung SSIM dalam O(1) dari summed-area table
+double ErrorMetrics::calculateSSIM(const ImageStatistics& stats, 
+                                  const Block& region, 
+                                  const RGB& avgColor) {
+    long long count = stats.getPixelCount(region);
+    unsigned char avgVal[3] = { avgColor.getRed(), avgColor.getGreen(), avgColor.getBlue() };
+    double ssim[3];
+    
+    for (int c = 0; c < 3; c++) {
+        if (count == 0) {
+            ssim[c] = 1.0;  // Sama dengan versi per piksel untuk region kosong
+            continue;
+        }
+        double sigma1_sq = static_cast<double>(stats.getChannelSquaredError(region, c, avgVal[c])) / count;
+        ssim[c] = ssimFromVariance(static_cast<double>(avgVal[c]), sigma1_sq);
+    }
+    
+    return 0.299 * ssim[0] + 0.587 * ssim[1] + 0.114 * ssim[2];
+}
+
+// Variance residual = SSE least squares / jumlah piksel
+double ErrorMetrics::calculateVariance(const LeafModel& model) {
+    double count = model.getRegion().getWidth() * static_cast<double>(model.getRegion().getHeight());
+    if (count <= 0) {
+        return 0.0;
+    }
+    return (model.getSquaredError(0) + model.getSquaredError(1) + model.getSquaredError(2)) / (3.0 * count);
+}
+
+// Prediksi least squares memenuhi cov(p, q) = var(q) = var(p) - SSE/n
+double ErrorMetrics::calculateSSIM(const LeafModel& model) {
+    const double C1 = 0.01 * 255 * 0.01 * 255;
+    const double C2 = 0.03 * 255 * 0.03 * 255;
+    double count = model.getRegion().getWidth() * static_cast<double>(model.getRegion().getHeight());
+    double ssim[3];
+
+    for (int c = 0; c < 3; c++) {
+        if (count <= 0) {
+            ssim[c] = 0.0;
+            continue;
+        }
+        double mu = model.getMean(c);
+        double sigma1_sq = model.getVariance(c);
+        double explained = std::max(0.0, sigma1_sq - model.getSquaredError(c) / count);
+        double value = ((2 * mu * mu + C1) * (2 * explained + C2)) /
+                       ((2 * mu * mu + C1) * (sigma1_sq + explained + C2));
+        ssim[c] = 1.0 - value;
+    }
+
+    return 0.299 * ssim[0] + 0.587 * ssim[1] + 0.114 * ssim[2];
+}
+
+double ErrorMetrics::calculateMAD(const vector<vector<RGB>>& image, 
+                                  const LeafModel& model) {
+    const Block& region = model.getRegion();
+    double sumAbsDiff = 0.0;
+    long long count = 0;
+
+    for (int y = region.getY(); y < region.getY() + region.getHeight() && y < (int)image.size(); y++) {
+        for (int x = region.getX(); x < region.getX() + region.getWidth() && x < (int)image[y].size(); x++) {
+            RGB predicted = model.predict(x, y);
+            sumAbsDiff += abs(image[y][x].getRed() - predicted.getRed())
+                        + abs(image[y][x].getGreen() - predicted.getGreen())
+                        + abs(image[y][x].getBlue() - predicted.getBlue());
+            count += 3;
+        }
+    }
+
+    return count == 0 ? 0.0 : sumAbsDiff / count;
+}
+
+// Sama seperti versi warna rata-rata: rentang (maks - min) per channel, dirata-rata
+double ErrorMetrics::calculateMaxDifference(const vector<vector<RGB>>& image, 
+                                            const LeafModel& model) {
+    const Block& region = model.getRegion();
+    int minDiff[3] = { 255, 255, 255 };
+    int maxDiff[3] = { -255, -255, -255 };
+    bool any = false;
+
+    for (int y = region.getY(); y < region.getY() + region.getHeight() && y < (int)image.size(); y++) {
+        for (int x = region.getX(); x < region.getX() + region.getWidth() && x < (int)image[y].size(); x++) {
+            RGB predicted = model.predict(x, y);
+            int diff[3] = { image[y][x].getRed() - predicted.getRed(),
+                            image[y][x].getGreen() - predicted.getGreen(),
+                            image[y][x].getBlue() - predicted.getBlue() };
+            for (int c = 0; c < 3; c++) {
+                minDiff[c] = min(minDiff[c], diff[c]);
+                maxDiff[c] = max(maxDiff[c], diff[c]);
+            }
+            any = true;
+        }
+    }
+
+    if (!any) {
+        return 0.0;
+    }
+    return ((maxDiff[0] - minDiff[0]) + (maxDiff[1] - minDiff[1]) + (maxDiff[2] - minDiff[2])) / 3.0;
+}
+
+double ErrorMetrics::calculateEntropy(const vector<vector<RGB>>& image, 
+                                      const LeafModel& model) {
+    const Block& region = model.getRegion();
+    // Residual berada di rentang -255..255
+    vector<int> histogram[3] = { vector<int>(511, 0), vector<int>(511, 0), vector<int>(511, 0) };
+    long long totalPixels = 0;
+
+    for (int y = region.getY(); y < region.getY() + region.getHeight() && y < (int)image.size(); y++) {
+        for (int x = region.getX(); x < region.getX() + region.getWidth() && x < (int)image[y].size(); x++) {
+            RGB predicted = model.predict(x, y);
+            histogram[0][image[y][x].getRed() - predicted.getRed() + 255]++;
+            histogram[1][image[y][x].getGreen() - predicted.getGreen() + 255]++;
+            histogram[2][image[y][x].getBlue() - predicted.getBlue() + 255]++;
+            totalPixels++;
+        }
+    }
+
+    if (totalPixels == 0) {
+        return 0.0;
+    }
+
+    double entropy = 0.0;
+    for (int c = 0; c < 3; c++) {
+        for (int frequency : histogram[c]) {
+            if (frequency > 0) {
+                double probability = static_cast<double>(frequency) / totalPixels;
+                entropy -= probability * log2(probability);
+            }
+        }
+    }
+    return entropy / 3.0;
+}
+
+// Menghitung PSNR antara gambar original dan hasil kompresi
+double ErrorMetrics::calculatePSNR(const vector<vector<RGB>>& original, 
+                                   const unsigned char* compressed) {
+    double sumSquaredDiff = 0.0;
+    long long count = 0;
+    
+    for (size_t y = 0; y < original.size(); y++) {
+        for (size_t x = 0; x < original[y].size(); x++) {
+            double dr = static_cast<double>(original[y][x].getRed()) - compressed[0];
+            double dg = static_cast<double>(original[y][x].getGreen()) - compressed[1];
+            double db = static_cast<double>(original[y][x].getBlue()) - compressed[2];
+            sumSquaredDiff += dr * dr + dg * dg + db * db;
+            count += 3;
+            compressed += 3;
+        }
+    }
+    
+    if (count == 0 || sumSquaredDiff == 0.0) {
+        return 100.0;
+    }
+    
+    double mse = sumSquaredDiff / count;
+    return 10.0 * log10(255.0 * 255.0 / mse);
+}
+
+// Menghitung rata-rata SSIM luminance pada window 8x8 yang tidak overlap
+double ErrorMetrics::calculateImageSSIM(const vector<vector<RGB>>& original, 
+                                        const unsigned char* compressed) {
+    const double C1 = 0.01 * 255 * 0.01 * 255;
+    const double C2 = 0.03 * 255 * 0.03 * 255;
+    const int window = 8;
+    
+    int height = static_cast<int>(original.size());
+    int width = height > 0 ? static_cast<int>(original[0].size()) : 0;
+    
+    auto luma = [](const RGB& pixel) {
+        return 0.299 * pixel.getRed() + 0.587 * pixel.getGreen() + 0.114 * pixel.getBlue();
+    };
+    auto compressedLuma = [compressed, width](int x, int y) {
+        const unsigned char* pixel = compressed + (static_cast<size_t>(y) * width + x) * 3;
+        return 0.299 * pixel[0] + 0.587 * pixel[1] + 0.114 * pixel[2];
+    };
+    
+    double totalSSIM = 0.0;
+    int windowCount = 0;
+    
+    for (int wy = 0; wy < height; wy += window) {
+        for (int wx = 0; wx < width; wx += window) {
+            double sum1 = 0.0, sum2 = 0.0, sumSq1 = 0.0, sumSq2 = 0.0, sum12 = 0.0;
+            int n = 0;
+            
+            for (int y = wy; y < wy + window && y < height; y++) {
+                for (int x = wx; x < wx + window && x < width; x++) {
+                    double a = luma(original[y][x]);
+                    double b = compressedLuma(x, y);
+                    sum1 += a;
+                    sum2 += b;
+                    sumSq1 += a * a;
+                    sumSq2 += b * b;
+                    sum12 += a * b;
+                    n++;
+                }
+            }
+            
+            double mu1 = sum1 / n;
+            double mu2 = sum2 / n;
+            double sigma1_sq = sumSq1 / n - mu1 * mu1;
+            double sigma2_sq = sumSq2 / n - mu2 * mu2;
+            double sigma12 = sum12 / n - mu1 * mu2;
+            
+            totalSSIM += ((2 * mu1 * mu2 + C1) * (2 * sigma12 + C2)) / 
+                         ((mu1 * mu1 + mu2 * mu2 + C1) * (sigma1_sq + sigma2_sq + C2));
+            windowCount++;
+        }
+    }
+    
+    return windowCount > 0 ? totalSSIM / windowCount : 1.0;
 }
\ No newline at end of file
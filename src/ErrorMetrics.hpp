@@ -4,6 +4,8 @@
 #include <vector>
 #include "RGB.hpp"
 #include "Block.hpp"
+#include "ImageStatistics.hpp"
+#include "LeafModel.hpp"
 
 using namespace std;
 
@@ -65,6 +67,87 @@ class ErrorMetrics {
         static double calculateSSIM(const vector<vector<RGB>>&, 
                                     const Block&, 
                                     const RGB&);
+
+        /**
+         * @brief Menghitung variance RGB dalam O(1) menggunakan statistik gambar
+         * @param Statistik gambar yang dianalisis
+         * @param Region yang dihitung variance-nya
+         * @param Warna rata-rata region
+         * @return Nilai variance (sama dengan versi per piksel)
+         */
+        static double calculateVariance(const ImageStatistics&, 
+                                        const Block&, 
+                                        const RGB&);
+
+        /**
+         * @brief Menghitung SSIM dalam O(1) menggunakan statistik gambar
+         * @param Statistik gambar yang dianalisis
+         * @param Region yang dihitung SSIM-nya
+         * @param Warna rata-rata region
+         * @return Nilai SSIM (sama dengan versi per piksel)
+         */
+        static double calculateSSIM(const ImageStatistics&, 
+                                    const Block&, 
+                                    const RGB&);
+
+        /**
+         * @brief Menghitung variance residual leaf model dalam O(1)
+         * @param Leaf model yang sudah di-fit
+         * @return Rata-rata variance residual ketiga channel
+         */
+        static double calculateVariance(const LeafModel&);
+
+        /**
+         * @brief Menghitung error SSIM antara region asli dan prediksi leaf model dalam O(1)
+         * @param Leaf model yang sudah di-fit
+         * @return Error SSIM (1 - SSIM)
+         */
+        static double calculateSSIM(const LeafModel&);
+
+        /**
+         * @brief Menghitung MAD residual terhadap prediksi leaf model
+         * @param Gambar yang dianalisis
+         * @param Leaf model yang sudah di-fit
+         * @return Nilai MAD
+         */
+        static double calculateMAD(const vector<vector<RGB>>&, 
+                                   const LeafModel&);
+
+        /**
+         * @brief Menghitung rentang residual terhadap prediksi leaf model
+         * @param Gambar yang dianalisis
+         * @param Leaf model yang sudah di-fit
+         * @return Nilai perbedaan maksimum
+         */
+        static double calculateMaxDifference(const vector<vector<RGB>>&, 
+                                             const LeafModel&);
+
+        /**
+         * @brief Menghitung entropy residual terhadap prediksi leaf model
+         * @param Gambar yang dianalisis
+         * @param Leaf model yang sudah di-fit
+         * @return Nilai entropy
+         */
+        static double calculateEntropy(const vector<vector<RGB>>&, 
+                                       const LeafModel&);
+
+        /**
+         * @brief Menghitung PSNR antara dua gambar berukuran sama
+         * @param Gambar original
+         * @param Gambar hasil kompresi, RGB interleaved berukuran sama dengan gambar original
+         * @return PSNR dalam dB (100 jika identik)
+         */
+        static double calculatePSNR(const vector<vector<RGB>>&, 
+                                    const unsigned char*);
+
+        /**
+         * @brief Menghitung rata-rata SSIM luminance seluruh gambar pada window 8x8
+         * @param Gambar original
+         * @param Gambar hasil kompresi, RGB interleaved berukuran sama dengan gambar original
+         * @return Nilai SSIM (1 = identik)
+         */
+        static double calculateImageSSIM(const vector<vector<RGB>>&, 
+                                         const unsigned char*);
         
     private:
         /**
@@ -129,6 +212,14 @@ class ErrorMetrics {
                                         const Block&, 
                                         const RGB&, 
                                         int);
+
+        /**
+         * @brief Menghitung SSIM satu channel dari variance region
+         * @param Nilai rata-rata channel
+         * @param Variance channel terhadap nilai rata-rata
+         * @return Error SSIM (1 - SSIM)
+         */
+        static double ssimFromVariance(double, double);
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "FrameStreamWriter.hpp"
+#include "Utils.hpp"
+#include <iostream>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+    // BT.601 studio range (16-235 / 16-240), bilangan bulat seperti konversi encoder video umumnya
+    inline unsigned char toY(int r, int g, int b) {
+        return static_cast<unsigned char>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+    }
+
+    inline unsigned char toU(int r, int g, int b) {
+        return static_cast<unsigned char>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+    }
+
+    inline unsigned char toV(int r, int g, int b) {
+        return static_cast<unsigned char>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+}
+
+FrameStreamWriter::FrameStreamWriter()
+    : file(nullptr), ownsFile(false), format(Y4M), width(0), height(0), frameCount(0), failed(false) {
+}
+
+FrameStreamWriter::~FrameStreamWriter() {
+    if (file) {
+        close();
+    }
+}
+
+FrameStreamWriter::Format FrameStreamWriter::formatFromPath(const string& path) {
+    return Utils::getFileExtension(path) == "ppm" ? PPM : Y4M;
+}
+
+bool FrameStreamWriter::open(const string& path, Format streamFormat, int frameWidth, int frameHeight, int frameRate) {
+    if (frameWidth <= 0 || frameHeight <= 0 || frameRate <= 0) {
+        std::cerr << "Error: Invalid frame stream size" << std::endl;
+        return false;
+    }
+
+    if (path == "-") {
+        file = stdout;
+        ownsFile = false;
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    } else {
+        file = fopen(path.c_str(), "wb");
+        ownsFile = true;
+        if (!file) {
+            std::cerr << "Error: Cannot open " << path << " for writing" << std::endl;
+            return false;
+        }
+    }
+
+    format = streamFormat;
+    width = frameWidth;
+    height = frameHeight;
+    frameCount = 0;
+    failed = false;
+    frame.assign(static_cast<size_t>(width) * height * 3, 0);
+
+    if (format == Y4M) {
+        string header = "YUV4MPEG2 W" + std::to_string(width) + " H" + std::to_string(height) +
+                        " F" + std::to_string(frameRate) + ":1 Ip A1:1 C444\n";
+        failed = fwrite(header.data(), 1, header.size(), file) != header.size();
+        frameHeader = "FRAME\n";
+    } else {
+        frameHeader = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+    }
+    return !failed;
+}
+
+bool FrameStreamWriter::writeFrame(const unsigned char* canvas, int left, int top, int rectWidth, int rectHeight) {
+    if (!file || left < 0 || top < 0 || rectWidth < 0 || rectHeight < 0 ||
+        left + rectWidth > width || top + rectHeight > height) {
+        std::cerr << "Error: Invalid frame for stream output" << std::endl;
+        return false;
+    }
+
+    size_t planeSize = static_cast<size_t>(width) * height;
+    for (int y = top; y < top + rectHeight; y++) {
+        const unsigned char* source = canvas + (static_cast<size_t>(y) * width + left) * 4;
+        size_t offset = static_cast<size_t>(y) * width + left;
+        if (format == Y4M) {
+            unsigned char* planeY = &frame[offset];
+            unsigned char* planeU = planeY + planeSize;
+            unsigned char* planeV = planeU + planeSize;
+            for (int x = 0; x < rectWidth; x++, source += 4) {
+                planeY[x] = toY(source[0], source[1], source[2]);
+                planeU[x] = toU(source[0], source[1], source[2]);
+                planeV[x] = toV(source[0], source[1], source[2]);
+            }
+        } else {
+            unsigned char* target = &frame[offset * 3];
+            for (int x = 0; x < rectWidth; x++, source += 4, target += 3) {
+                target[0] = source[0];
+                target[1] = source[1];
+                target[2] = source[2];
+            }
+        }
+    }
+
+    bool written = fwrite(frameHeader.data(), 1, frameHeader.size(), file) == frameHeader.size() &&
+                   fwrite(frame.data(), 1, frame.size(), file) == frame.size();
+    failed = failed || !written;
+    frameCount++;
+    return written;
+}
+
+bool FrameStreamWriter::close() {
+    if (!file) {
+        return false;
+    }
+    bool success = fflush(file) == 0 && !ferror(file) && !failed;
+    if (ownsFile) {
+        success = fclose(file) == 0 && success;
+    }
+    file = nullptr;
+    return success;
+}
+
+int FrameStreamWriter::getFrameCount() const {
+    return frameCount;
+}
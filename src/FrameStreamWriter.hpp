@@ -0,0 +1,75 @@
+#ifndef __FRAME_STREAM_WRITER__HPP__
+#define __FRAME_STREAM_WRITER__HPP__
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class FrameStreamWriter
+ * @brief Penulis animasi sebagai stream frame mentah tanpa kuantisasi palet dan tanpa kompresi:
+ *        YUV4MPEG2 (4:4:4, BT.601) atau rangkaian PPM (P6) 24-bit, ke file atau stdout ("-"),
+ *        sehingga dapat langsung di-pipe ke encoder video. Frame disimpan dalam format output dan
+ *        hanya persegi panjang yang berubah yang dikonversi ulang setiap frame
+ */
+class FrameStreamWriter {
+public:
+    enum Format {
+        Y4M,
+        PPM
+    };
+
+    FrameStreamWriter();
+    ~FrameStreamWriter();
+
+    /**
+     * @brief Format dari ekstensi path: .ppm untuk rangkaian PPM, selain itu YUV4MPEG2
+     * @param Path output ("-" untuk stdout)
+     */
+    static Format formatFromPath(const string&);
+
+    /**
+     * @brief Membuka output dan menulis header stream
+     * @param Path output ("-" untuk stdout)
+     * @param Format stream
+     * @param Lebar frame
+     * @param Tinggi frame
+     * @param Frame per detik
+     * @return true jika berhasil
+     */
+    bool open(const string&, Format, int, int, int);
+
+    /**
+     * @brief Menulis satu frame lengkap setelah memperbarui persegi panjang yang berubah
+     * @param Kanvas RGBA penuh (lebar x tinggi x 4)
+     * @param Kiri persegi panjang yang berubah
+     * @param Atas persegi panjang yang berubah
+     * @param Lebar persegi panjang
+     * @param Tinggi persegi panjang
+     * @return true jika berhasil
+     */
+    bool writeFrame(const unsigned char*, int, int, int, int);
+
+    /**
+     * @brief Menutup output (stdout hanya di-flush)
+     * @return true jika semua frame berhasil ditulis
+     */
+    bool close();
+
+    int getFrameCount() const;
+
+private:
+    FILE* file;
+    bool ownsFile;
+    Format format;
+    int width, height;
+    int frameCount;
+    bool failed;
+    string frameHeader;             // Header per frame ("FRAME\n" atau header P6)
+    vector<unsigned char> frame;    // Frame dalam layout output (bidang Y/U/V atau RGB interleaved)
+};
+
+#endif
@@ -0,0 +1,302 @@
+#include "GifPipeline.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+#include "lib/gif.h"
+
+/**
+ * @brief Palet global GIF dari warna node tree: index 0 transparan, warna di index 1..255.
+ *        Warna tree dipetakan lewat tabel hash, warna lain (leaf model) lewat LUT RGB 15-bit
+ */
+class GifPipeline::ColorTable {
+public:
+    ColorTable() {
+        memset(&palette, 0, sizeof(palette));
+        palette.bitDepth = 8;
+    }
+
+    // Palet persis jika warna unik muat, selain itu median cut gif.h atas warna unik
+    void build(const vector<RGB>& colors) {
+        vector<uint32_t> unique;
+        unique.reserve(colors.size());
+        for (const RGB& color : colors) {
+            uint32_t key = pack(color.getRed(), color.getGreen(), color.getBlue());
+            if (exact.emplace(key, 0).second) {
+                unique.push_back(key);
+            }
+        }
+
+        if (unique.size() < 256) {
+            for (size_t i = 0; i < unique.size(); i++) {
+                setEntry(static_cast<int>(i) + 1, unique[i]);
+                exact[unique[i]] = static_cast<uint8_t>(i + 1);
+            }
+            return;
+        }
+
+        vector<uint8_t> pixels(unique.size() * 4);
+        for (size_t i = 0; i < unique.size(); i++) {
+            pixels[i * 4 + 0] = static_cast<uint8_t>(unique[i] >> 16);
+            pixels[i * 4 + 1] = static_cast<uint8_t>(unique[i] >> 8);
+            pixels[i * 4 + 2] = static_cast<uint8_t>(unique[i]);
+        }
+        GifMakePalette(NULL, pixels.data(), static_cast<uint32_t>(unique.size()), 1, 8, false, &palette);
+        for (uint32_t key : unique) {
+            exact[key] = nearest(key >> 16, (key >> 8) & 0xFF, key & 0xFF);
+        }
+    }
+
+    uint8_t lookup(uint8_t r, uint8_t g, uint8_t b) {
+        auto entry = exact.find(pack(r, g, b));
+        if (entry != exact.end()) {
+            return entry->second;
+        }
+        if (approximate.empty()) {
+            approximate.resize(1 << 15);
+            for (int cell = 0; cell < (1 << 15); cell++) {
+                approximate[cell] = nearest(((cell >> 10) << 3) | 4, (((cell >> 5) & 31) << 3) | 4, ((cell & 31) << 3) | 4);
+            }
+        }
+        return approximate[((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3)];
+    }
+
+    const GifPalette& getPalette() const {
+        return palette;
+    }
+
+private:
+    GifPalette palette;
+    unordered_map<uint32_t, uint8_t> exact;
+    vector<uint8_t> approximate;
+
+    static uint32_t pack(uint8_t r, uint8_t g, uint8_t b) {
+        return (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+    }
+
+    void setEntry(int index, uint32_t key) {
+        palette.r[index] = static_cast<uint8_t>(key >> 16);
+        palette.g[index] = static_cast<uint8_t>(key >> 8);
+        palette.b[index] = static_cast<uint8_t>(key);
+    }
+
+    // Jarak L1 seperti gif.h; index 0 (transparan) tidak pernah dipilih
+    uint8_t nearest(int r, int g, int b) const {
+        int best = 1, bestDiff = INT_MAX;
+        for (int i = 1; i < 256; i++) {
+            int diff = abs(r - palette.r[i]) + abs(g - palette.g[i]) + abs(b - palette.b[i]);
+            if (diff < bestDiff) {
+                best = i;
+                bestDiff = diff;
+            }
+        }
+        return static_cast<uint8_t>(best);
+    }
+};
+
+GifPipeline::GifPipeline()
+    : width(0), height(0), delay(0), bytesPerPixel(4), queueDepth(0), submitted(0), failed(false),
+      inFlight(0), nextToWrite(0), closing(false) {
+}
+
+GifPipeline::~GifPipeline() {
+    if (writer) {
+        close();
+    }
+}
+
+void GifPipeline::setGlobalPalette(const vector<RGB>& colors) {
+    colorTable.reset(new ColorTable());
+    colorTable->build(colors);
+    bytesPerPixel = 1;
+}
+
+bool GifPipeline::isIndexed() const {
+    return colorTable != nullptr;
+}
+
+uint8_t GifPipeline::getColorIndex(const RGB& color) {
+    return colorTable->lookup(color.getRed(), color.getGreen(), color.getBlue());
+}
+
+void GifPipeline::mapColors(const unsigned char* rgb, size_t count, unsigned char* indices) {
+    for (size_t i = 0; i < count; i++, rgb += 3) {
+        indices[i] = colorTable->lookup(rgb[0], rgb[1], rgb[2]);
+    }
+}
+
+bool GifPipeline::open(const string& path, int canvasWidth, int canvasHeight, int frameDelay, int threads, int depth) {
+    if (writer) {
+        std::cerr << "Error: GIF pipeline is already open" << std::endl;
+        return false;
+    }
+    if (canvasWidth <= 0 || canvasHeight <= 0 || canvasWidth > 0xFFFF || canvasHeight > 0xFFFF) {
+        std::cerr << "Error: Invalid GIF canvas size" << std::endl;
+        return false;
+    }
+
+    // oldImage GifWriter menyimpan isi kanvas pada frame terakhir yang diserahkan
+    writer.reset(new GifWriter());
+    if (!GifBegin(writer.get(), path.c_str(), canvasWidth, canvasHeight, frameDelay, 8, false,
+                  colorTable ? &colorTable->getPalette() : NULL)) {
+        writer.reset();
+        std::cerr << "Error: Cannot open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    width = canvasWidth;
+    height = canvasHeight;
+    delay = frameDelay;
+    submitted = 0;
+    failed = false;
+    inFlight = 0;
+    nextToWrite = 0;
+    closing = false;
+
+    int workerCount = std::max(1, threads > 0 ? threads : Utils::getDefaultThreadCount());
+    queueDepth = depth > 0 ? static_cast<size_t>(depth) : static_cast<size_t>(workerCount) * 2;
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&GifPipeline::workerLoop, this);
+    }
+    writerThread = std::thread(&GifPipeline::writerLoop, this);
+    return true;
+}
+
+bool GifPipeline::submitFrame(const unsigned char* canvas, int left, int top, int rectWidth, int rectHeight) {
+    if (!writer || rectWidth <= 0 || rectHeight <= 0 || left < 0 || top < 0 ||
+        left + rectWidth > width || top + rectHeight > height) {
+        std::cerr << "Error: Invalid GIF frame rectangle" << std::endl;
+        return false;
+    }
+
+    Job job;
+    job.sequence = submitted;
+    job.left = left;
+    job.top = top;
+    job.width = rectWidth;
+    job.height = rectHeight;
+    job.first = submitted == 0;
+
+    // Salin persegi panjang sekarang dan sebelumnya, lalu perbarui kanvas frame sebelumnya
+    size_t rowBytes = static_cast<size_t>(rectWidth) * bytesPerPixel;
+    size_t canvasStride = static_cast<size_t>(width) * bytesPerPixel;
+    job.next.resize(rowBytes * rectHeight);
+    job.last.resize(rowBytes * rectHeight);
+    for (int y = 0; y < rectHeight; y++) {
+        size_t offset = (top + y) * canvasStride + static_cast<size_t>(left) * bytesPerPixel;
+        std::memcpy(&job.next[y * rowBytes], canvas + offset, rowBytes);
+        std::memcpy(&job.last[y * rowBytes], writer->oldImage + offset, rowBytes);
+        std::memcpy(writer->oldImage + offset, canvas + offset, rowBytes);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    spaceAvailable.wait(lock, [this]() { return inFlight < queueDepth; });
+    jobs.push_back(std::move(job));
+    inFlight++;
+    submitted++;
+    jobReady.notify_one();
+    return true;
+}
+
+bool GifPipeline::close() {
+    if (!writer) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    jobReady.notify_all();
+    resultReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    writerThread.join();
+
+    bool success = !failed && !ferror(writer->f);
+    GifEnd(writer.get());
+    writer.reset();
+    return success;
+}
+
+int GifPipeline::getFrameCount() const {
+    return submitted;
+}
+
+void GifPipeline::workerLoop() {
+    // Kamus LZW dialokasikan sekali per worker dan dipakai ulang untuk setiap frame
+    unique_ptr<GifLzwTable, void (*)(GifLzwTable*)> dictionary(GifLzwCreate(), GifLzwFree);
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobReady.wait(lock, [this]() { return !jobs.empty() || closing; });
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        // Frame yang gagal tetap menghasilkan entri kosong agar writer tidak menunggu selamanya
+        vector<uint8_t> encoded;
+        bool success = true;
+        try {
+            encode(job, encoded, dictionary.get());
+        } catch (const std::exception& e) {
+            std::cerr << "GIF frame " << job.sequence << " encoding error: " << e.what() << std::endl;
+            encoded.clear();
+            success = false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        failed = failed || !success;
+        results[job.sequence] = std::move(encoded);
+        resultReady.notify_one();
+    }
+}
+
+void GifPipeline::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        resultReady.wait(lock, [this]() {
+            return results.count(nextToWrite) > 0 || (closing && nextToWrite == submitted);
+        });
+        auto ready = results.find(nextToWrite);
+        if (ready == results.end()) {
+            return;
+        }
+        vector<uint8_t> data = std::move(ready->second);
+        results.erase(ready);
+
+        lock.unlock();
+        bool written = data.empty() || GifWriteEncodedFrame(writer.get(), data.data(), data.size());
+        lock.lock();
+
+        failed = failed || !written;
+        nextToWrite++;
+        inFlight--;
+        spaceAvailable.notify_one();
+    }
+}
+
+void GifPipeline::encode(const Job& job, vector<uint8_t>& encoded, GifLzwTable* dictionary) const {
+    GifOutput out = GifMemoryOutput();
+    if (colorTable) {
+        GifEncodeIndexedRect(job.first ? NULL : job.last.data(), job.next.data(), job.left, job.top,
+                             job.width, job.height, delay, 8, &out, dictionary);
+    } else {
+        // Transparansi dibandingkan dengan isi sumber frame sebelumnya, bukan hasil kuantisasinya,
+        // sehingga setiap frame dapat dikodekan tanpa menunggu frame sebelumnya
+        vector<uint8_t> quantized(job.next.size());
+        GifEncodeFrameRect(job.first ? NULL : job.last.data(), job.next.data(), quantized.data(), job.left, job.top,
+                           job.width, job.height, delay, 8, &out, dictionary);
+    }
+    encoded.assign(out.data, out.data + out.size);
+    GifOutputFree(&out);
+}
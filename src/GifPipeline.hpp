@@ -0,0 +1,127 @@
+#ifndef __GIF_PIPELINE__HPP__
+#define __GIF_PIPELINE__HPP__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RGB.hpp"
+
+using namespace std;
+
+struct GifWriter;
+struct GifLzwTable;
+
+/**
+ * @class GifPipeline
+ * @brief Penulis animasi GIF producer/consumer. Thread pemanggil menyerahkan persegi panjang frame
+ *        yang berubah ke antrian terbatas, worker thread membangun palet dan mengompres LZW secara
+ *        paralel, dan satu writer thread menulis hasilnya ke file sesuai urutan frame. Memori
+ *        sebanding dengan kedalaman antrian, bukan jumlah frame
+ */
+class GifPipeline {
+public:
+    GifPipeline();
+    ~GifPipeline();
+
+    /**
+     * @brief Memakai satu palet global (index 0 transparan) alih-alih palet per frame; dipanggil sebelum open.
+     *        Hingga 255 warna unik disimpan persis, selebihnya direduksi dengan median cut
+     * @param Warna yang muncul di animasi
+     */
+    void setGlobalPalette(const vector<RGB>&);
+
+    /**
+     * @brief Apakah kanvas berisi index palet global (1 byte per piksel) alih-alih RGBA
+     */
+    bool isIndexed() const;
+
+    /**
+     * @brief Index palet global untuk sebuah warna (warna di luar palet dipetakan ke entri terdekat)
+     * @param Warna
+     */
+    uint8_t getColorIndex(const RGB&);
+
+    /**
+     * @brief Memetakan buffer RGB ke index palet global
+     * @param Buffer RGB interleaved
+     * @param Jumlah piksel
+     * @param Buffer index output, satu byte per piksel
+     */
+    void mapColors(const unsigned char*, size_t, unsigned char*);
+
+    /**
+     * @brief Membuat file GIF, menulis header, dan menjalankan worker serta writer thread
+     * @param Path file output
+     * @param Lebar kanvas
+     * @param Tinggi kanvas
+     * @param Delay antar frame (seperseratus detik)
+     * @param Jumlah worker thread (0 = otomatis)
+     * @param Kedalaman antrian frame (0 = dua kali jumlah worker)
+     * @return true jika berhasil
+     */
+    bool open(const string&, int, int, int, int = 0, int = 0);
+
+    /**
+     * @brief Menyerahkan frame yang hanya mengubah persegi panjang tertentu dari kanvas. Persegi panjang
+     *        disalin sehingga kanvas boleh langsung diubah lagi; memblokir selama antrian penuh
+     * @param Kanvas penuh (RGBA, atau index palet jika isIndexed)
+     * @param Kiri persegi panjang yang berubah
+     * @param Atas persegi panjang yang berubah
+     * @param Lebar persegi panjang
+     * @param Tinggi persegi panjang
+     * @return true jika frame diterima
+     */
+    bool submitFrame(const unsigned char*, int, int, int, int);
+
+    /**
+     * @brief Menunggu semua frame ditulis, menutup file, dan menghentikan thread
+     * @return true jika semua frame berhasil dikodekan dan ditulis
+     */
+    bool close();
+
+    int getFrameCount() const;
+
+private:
+    class ColorTable;
+
+    // Deskriptor frame: persegi panjang kanvas saat ini dan isinya pada frame sebelumnya
+    struct Job {
+        int sequence;
+        int left, top, width, height;
+        bool first;
+        vector<uint8_t> next;
+        vector<uint8_t> last;
+    };
+
+    unique_ptr<GifWriter> writer;
+    unique_ptr<ColorTable> colorTable;
+    int width, height, delay;
+    int bytesPerPixel;
+    size_t queueDepth;
+    int submitted;
+    bool failed;
+
+    std::mutex mutex;
+    std::condition_variable jobReady;         // Worker: ada job baru atau pipeline ditutup
+    std::condition_variable resultReady;      // Writer: ada frame selesai dikodekan
+    std::condition_variable spaceAvailable;   // Producer: jumlah frame yang belum ditulis turun
+    deque<Job> jobs;
+    map<int, vector<uint8_t>> results;        // Frame terkode yang menunggu gilirannya ditulis
+    size_t inFlight;                          // Frame yang sudah diserahkan tetapi belum ditulis
+    int nextToWrite;
+    bool closing;
+    vector<std::thread> workers;
+    std::thread writerThread;
+
+    void workerLoop();
+    void writerLoop();
+    void encode(const Job&, vector<uint8_t>&, GifLzwTable*) const;
+};
+
+#endif
@@ -4,22 +4,53 @@
 #define GIF_IMPL  
 #include "ImageProcessor.hpp"
 #include "Utils.hpp"
+#include "QtcCodec.hpp"
+#include "TreeIndex.hpp"
+#include "PngWriter.hpp"
+#include "SvgWriter.hpp"
+#include "QoiCodec.hpp"
+#include "BandWriter.hpp"
+#include "Deflate.hpp"
+#include "GifPipeline.hpp"
+#include "FrameStreamWriter.hpp"
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <iomanip>
 #include <fstream>
 #include <sstream>
 #include <cmath>
-#include <windows.h>
-#undef RGB
+#include <cstring>
+#include <set>
+#include <unordered_map>
 
 
 #include "lib/stb_image.h"
 #include "lib/stb_image_write.h"
-#include "lib/gif.h"
 
+namespace {
+    // Memetakan raster RGB interleaved ke indeks palet; setiap warna piksel pasti ada di palet
+    void indexPixels(const unsigned char* pixels, size_t pixelCount, const vector<RGB>& palette,
+                     unsigned char* indices) {
+        unordered_map<uint32_t, unsigned char> lookup;
+        for (size_t i = 0; i < palette.size() && i < 256; i++) {
+            uint32_t key = (static_cast<uint32_t>(palette[i].getRed()) << 16) |
+                           (static_cast<uint32_t>(palette[i].getGreen()) << 8) | palette[i].getBlue();
+            lookup[key] = static_cast<unsigned char>(i);
+        }
+        uint32_t lastKey = 0xFFFFFFFF;
+        unsigned char lastIndex = 0;
+        for (size_t i = 0; i < pixelCount; i++, pixels += 3) {
+            uint32_t key = (static_cast<uint32_t>(pixels[0]) << 16) | (static_cast<uint32_t>(pixels[1]) << 8) | pixels[2];
+            if (key != lastKey) {
+                lastKey = key;
+                lastIndex = lookup[key];
+            }
+            indices[i] = lastIndex;
+        }
+    }
+}
 
-#define GIF_IMPL
 
 // Constructor
 ImageProcessor::ImageProcessor(const string& _inputPath, const string& _outputPath,
@@ -31,9 +62,79 @@ ImageProcessor::ImageProcessor(const string& _inputPath, const string& _outputPa
       width(0), height(0), channels(0), minBlockSize(_minBlockSize),
       threshold(_threshold), errorMetricType(_errorMetricType),
       targetCompressionPercentage(_targetCompressionPercentage),
-      quadTree(nullptr), compressionPercentage(0.0),
+      quadTree(nullptr), channelMode(PlanarQuadTree::JOINT), threadCount(0),
+      leafModel(LeafModel::FLAT), partitionMode(QuadTree::QUADRANT),
+      maxOutputBytes(0), jpegGrid(0), jpegQuality(90), bandHeight(0),
+      gifGlobalPalette(false), gifFrameCount(0), gifPerLevel(false), gifMaxDimension(0),
+      videoFormat(FrameStreamWriter::Y4M),
+      compressionPercentage(0.0),
       nodeCount(0), maxDepth(0), executionTime(0),
-      originalSize(0), compressedSize(0) {
+      originalSize(0), compressedSize(0), roiStrength(4.0) {
+}
+
+void ImageProcessor::setRoiMask(const string& path) {
+    roiMaskPath = path;
+}
+
+void ImageProcessor::addRoiRegion(const Block& region) {
+    roiRegions.push_back(region);
+}
+
+void ImageProcessor::setRoiStrength(double strength) {
+    roiStrength = strength;
+}
+
+void ImageProcessor::setChannelMode(PlanarQuadTree::ChannelMode mode) {
+    channelMode = mode;
+}
+
+void ImageProcessor::setThreadCount(int count) {
+    threadCount = count;
+}
+
+void ImageProcessor::setLeafModel(LeafModel::Type type) {
+    leafModel = type;
+}
+
+void ImageProcessor::setPartitionMode(QuadTree::PartitionMode mode) {
+    partitionMode = mode;
+}
+
+void ImageProcessor::setMaxOutputBytes(size_t bytes) {
+    maxOutputBytes = bytes;
+}
+
+void ImageProcessor::setJpegGrid(int grid) {
+    jpegGrid = grid;
+}
+
+void ImageProcessor::setJpegQuality(int quality) {
+    jpegQuality = quality;
+}
+
+void ImageProcessor::setBandHeight(int rows) {
+    bandHeight = rows;
+}
+
+void ImageProcessor::setGifGlobalPalette(bool global) {
+    gifGlobalPalette = global;
+}
+
+void ImageProcessor::setGifFrameCount(int frames) {
+    gifFrameCount = frames;
+}
+
+void ImageProcessor::setGifPerLevel(bool perLevel) {
+    gifPerLevel = perLevel;
+}
+
+void ImageProcessor::setGifMaxDimension(int pixels) {
+    gifMaxDimension = pixels;
+}
+
+void ImageProcessor::setVideoOutput(const string& path, FrameStreamWriter::Format format) {
+    videoPath = path;
+    videoFormat = format;
 }
 
 // Memuat gambar dari file
@@ -44,40 +145,84 @@ bool ImageProcessor::loadImage() {
         return false;
     }
     
-    // Load gambar menggunakan stb_image
-    stbi_set_flip_vertically_on_load(false);
-    unsigned char* data = stbi_load(inputPath.c_str(), &width, &height, &channels, 0);
-    
-    if (!data) {
-        std::cerr << "Error: Failed to load image - " << inputPath << std::endl;
-        return false;
+    vector<vector<RGB>> originalImage;
+    string inputExt = Utils::getFileExtension(inputPath);
+    if (inputExt == "qtc" || inputExt == "qtp" || inputExt == "qti") {
+        // File native didekode langsung dari bitstream tree (.qtp boleh terpotong)
+        bool decoded = false;
+        if (inputExt == "qtc") {
+            decoded = QtcCodec::decodeFromFile(inputPath, originalImage);
+        } else if (inputExt == "qtp") {
+            decoded = QtcCodec::decodeProgressiveFromFile(inputPath, originalImage);
+        } else {
+            TreeIndex index;
+            decoded = index.open(inputPath);
+            if (decoded) {
+                index.render(originalImage);
+            }
+        }
+        if (!decoded) {
+            std::cerr << "Error: Failed to load image - " << inputPath << std::endl;
+            return false;
+        }
+        height = originalImage.size();
+        width = originalImage[0].size();
+        channels = 3;
+    } else {
+        // QOI didekode codec sendiri, format lain menggunakan stb_image
+        vector<unsigned char> qoiPixels;
+        unsigned char* stbData = nullptr;
+        const unsigned char* data = nullptr;
+        if (inputExt == "qoi") {
+            if (QoiCodec::decodeFromFile(inputPath, qoiPixels, width, height, channels)) {
+                data = qoiPixels.data();
+            }
+        } else {
+            stbi_set_flip_vertically_on_load(false);
+            stbData = stbi_load(inputPath.c_str(), &width, &height, &channels, 0);
+            data = stbData;
+        }
+        
+        if (!data) {
+            std::cerr << "Error: Failed to load image - " << inputPath << std::endl;
+            return false;
+        }
+        
+        // Konversi data gambar ke format yang kita gunakan
+        originalImage.resize(height);
+        for (int y = 0; y < height; ++y) {
+            originalImage[y].resize(width);
+            for (int x = 0; x < width; ++x) {
+                int idx = (y * width + x) * channels;
+                unsigned char r = channels >= 1 ? data[idx] : 0;
+                unsigned char g = channels >= 2 ? data[idx + 1] : r;
+                unsigned char b = channels >= 3 ? data[idx + 2] : r;
+                originalImage[y][x] = RGB(r, g, b);
+            }
+        }
+        
+        // Free memory
+        if (stbData) {
+            stbi_image_free(stbData);
+        }
     }
     
     if (minBlockSize > (width * height)) {
         std::cerr << "Error: Minimum block area (" << minBlockSize << " square pixels) is larger than the image area (" 
                   << (width * height) << " square pixels)." << std::endl;
-        stbi_image_free(data);  
         return false;
     }
-    // Konversi data gambar ke format yang kita gunakan
-    originalImage.resize(height);
-    for (int y = 0; y < height; ++y) {
-        originalImage[y].resize(width);
-        for (int x = 0; x < width; ++x) {
-            int idx = (y * width + x) * channels;
-            unsigned char r = channels >= 1 ? data[idx] : 0;
-            unsigned char g = channels >= 2 ? data[idx + 1] : r;
-            unsigned char b = channels >= 3 ? data[idx + 2] : r;
-            originalImage[y][x] = RGB(r, g, b);
-        }
+    
+    // Gambar dipindahkan (tanpa salinan) ke statistik yang dipakai bersama semua QuadTree
+    statistics = make_shared<ImageStatistics>(make_shared<const vector<vector<RGB>>>(std::move(originalImage)));
+    
+    if (!loadImportanceMap()) {
+        return false;
     }
     
     // Hitung ukuran file original
     originalSize = Utils::getFileSize(inputPath);
     
-    // Free memory
-    stbi_image_free(data);
-    
     std::cout << "Image loaded: " << width << "x" << height 
               << ", channels: " << channels << std::endl;
     
@@ -101,42 +246,69 @@ bool ImageProcessor::compressImage() {
             threshold = newThreshold;
         }
         
-        // Buat dan bangun QuadTree
-        quadTree = make_unique<QuadTree>(originalImage, minBlockSize, threshold, errorMetricType);
-        
-        // Set callback jika gif path diset
-        if (!gifPath.empty()) {
-            std::cout << "GIF recording enabled." << std::endl;
-            // Capture frame untuk visualisasi
-            vector<vector<vector<RGB>>> frames;
+        if (channelMode != PlanarQuadTree::JOINT) {
+            // Tree terpisah per channel, dibangun paralel
+            planarTree = createPlanarQuadTree(threshold);
+            
+            std::cout << "Building per-channel quadtrees ("
+                      << (channelMode == PlanarQuadTree::YCBCR_PLANES ? "Y/Cb/Cr" : "R/G/B") << ")..." << std::endl;
+            planarTree->buildTree();
+            
+            if (!isTreeOutput(outputPath) && !isBandOutput(outputPath)) {
+                std::cout << "Retrieving compressed image..." << std::endl;
+                compressedPixels.assign(static_cast<size_t>(width) * height * 3, 0);
+                planarTree->rasterize(compressedPixels.data(), 3);
+            }
+            nodeCount = planarTree->getNodeCount();
+            maxDepth = planarTree->getMaxDepth();
+            compressionPercentage = planarTree->getCompressionPercentage();
+        } else {
+            // Buat dan bangun QuadTree
+            quadTree = createQuadTree(threshold);
+            
+            // Catat log split jika GIF atau stream frame diminta; animasi direplay dari log setelah build
+            if (!gifPath.empty() || !videoPath.empty()) {
+                std::cout << "Recording splits for "
+                  << (gifPath.empty() ? "frame stream" : (videoPath.empty() ? "GIF" : "GIF and frame stream"))
+                  << "." << std::endl;
+                quadTree->setRecordSplits(true);
+            }
+            
+            // Bangun tree
+            std::cout << "Building quadtree..." << std::endl;
+            quadTree->buildTree();
             
-            quadTree->setCompressionCallback([&frames](const vector<vector<RGB>>& frame) {
-                frames.push_back(frame);
-                std::cout << "Frame captured. Total frames: " << frames.size() << "\r" << std::flush;
-            });
+            // Dapatkan hasil kompresi dan metrik
+            // Format tree dan vektor ditulis langsung dari leaf, tanpa raster; PNG yang warnanya
+            // muat di palet hanya membutuhkan buffer indeks, bukan buffer RGB
+            if (!isTreeOutput(outputPath) && !isBandOutput(outputPath)) {
+                std::cout << "Retrieving compressed image..." << std::endl;
+                if (findOutputPalette(outputPath, *quadTree, compressedPalette)) {
+                    compressedIndices.assign(static_cast<size_t>(width) * height, 0);
+                    quadTree->rasterizeIndices(compressedIndices.data(), compressedPalette);
+                } else {
+                    compressedPixels.assign(static_cast<size_t>(width) * height * 3, 0);
+                    quadTree->rasterize(compressedPixels.data(), 3);
+                }
+            }
+            nodeCount = quadTree->getNodeCount();
+            maxDepth = quadTree->getMaxDepth();
+            compressionPercentage = quadTree->getCompressionPercentage();
         }
         
-        // Bangun tree
-        std::cout << "Building quadtree..." << std::endl;
-        quadTree->buildTree();
-        
-        // Dapatkan hasil kompresi dan metrik
-        std::cout << "Retrieving compressed image..." << std::endl;
-        compressedImage = quadTree->getCompressedImage();
-        nodeCount = quadTree->getNodeCount();
-        maxDepth = quadTree->getMaxDepth();
-        compressionPercentage = quadTree->getCompressionPercentage();
-        
         auto endTime = std::chrono::high_resolution_clock::now();
         executionTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
         
         // Hitung perkiraan ukuran file terkompresi
-        compressedSize = calculateImageSize(compressedImage);
+        compressedSize = static_cast<size_t>(width) * height * 3;
         
-        // Jika path GIF ditentukan, buat GIF visualisasi
-        if (!gifPath.empty()) {
-            std::cout << "Generating compression visualization GIF..." << std::endl;
-            generateCompressionGif();
+        // Jika path GIF atau stream frame ditentukan, buat animasi visualisasi
+        bool animationRequested = !gifPath.empty() || !videoPath.empty();
+        if (animationRequested && channelMode != PlanarQuadTree::JOINT) {
+            std::cerr << "Warning: GIF visualization is only available with a single joint tree, skipped" << std::endl;
+        } else if (animationRequested) {
+            std::cout << "Generating compression visualization..." << std::endl;
+            generateCompressionAnimation();
         }
         
         return true;
@@ -146,60 +318,343 @@ bool ImageProcessor::compressImage() {
     }
 }
 
+// Mencari parameter kompresi terbaik secara paralel
+bool ImageProcessor::autoTune(AutoTuner::GoalType goal, double target) {
+    if (!statistics) {
+        std::cerr << "Error: Image must be loaded before autotuning" << std::endl;
+        return false;
+    }
+    
+    AutoTuner tuner(statistics, threadCount);
+    tuner.setImportanceMap(importanceMap);
+    tuner.setLeafModel(leafModel);
+    tuner.setPartitionMode(partitionMode);
+    tuner.setSplitGrid(jpegGrid);
+    tuner.addDefaultCandidates();
+    
+    // Goal ukuran dan Pareto front memakai ukuran file yang akan ditulis, diukur dengan encode
+    // raster kandidat ke memori dalam format output (path default memakai ekstensi input)
+    string sizedPath = outputPath.empty() ? inputPath : outputPath;
+    tuner.setTreeHandler([this, sizedPath](AutoTuner::Candidate& candidate, const QuadTree& tree,
+                                           const unsigned char* pixels) {
+        candidate.outputSize = measureOutputSize(tree, sizedPath, pixels);
+    });
+    std::cout << "Evaluating " << tuner.getCandidates().size() << " parameter combinations..." << std::endl;
+    tuner.run();
+    tuner.displayReport();
+    
+    if (goal == AutoTuner::NO_GOAL) {
+        return false;
+    }
+    
+    int best = tuner.selectBest(goal, target);
+    if (best < 0) {
+        std::cerr << "Error: No autotune candidate could be evaluated" << std::endl;
+        return false;
+    }
+    
+    // Terapkan parameter terpilih untuk kompresi berikutnya
+    const AutoTuner::Candidate& selected = tuner.getCandidates()[best];
+    errorMetricType = selected.method;
+    threshold = selected.threshold;
+    minBlockSize = selected.minBlockSize;
+    targetCompressionPercentage = 0.0;
+    
+    std::cout << "Selected: " << Utils::errorMetricToString(errorMetricType)
+              << ", threshold " << threshold << ", min block " << minBlockSize
+              << " (PSNR " << selected.psnr << " dB, SSIM " << selected.ssim << ")" << std::endl;
+    
+    if (outputPath.empty()) {
+        outputPath = Utils::getDefaultOutputPath(inputPath, errorMetricType, threshold, minBlockSize);
+        std::cout << "Using default output path: " << outputPath << std::endl;
+    }
+    
+    return true;
+}
+
+bool ImageProcessor::sweep(const vector<QuadTree::ErrorMetricType>& methods, const vector<double>& thresholds,
+                           const vector<int>& blockSizes, const string& csvPath) {
+    if (!statistics) {
+        std::cerr << "Error: Image must be loaded before a sweep" << std::endl;
+        return false;
+    }
+    if (channelMode != PlanarQuadTree::JOINT) {
+        std::cerr << "Error: --sweep requires a single joint tree (--channels joint)" << std::endl;
+        return false;
+    }
+
+    // Decode, statistik, dan peta ROI dipakai bersama; setiap kombinasi hanya membangun tree-nya sendiri
+    AutoTuner tuner(statistics, threadCount);
+    tuner.setImportanceMap(importanceMap);
+    tuner.setLeafModel(leafModel);
+    tuner.setPartitionMode(partitionMode);
+    tuner.setSplitGrid(jpegGrid);
+    // Nilai ganda atau rentang yang tumpang tindih menghasilkan path output yang sama; kombinasi
+    // seperti itu hanya dibangun sekali agar dua worker tidak menulis file yang sama
+    set<string> outputPaths;
+    for (QuadTree::ErrorMetricType method : methods) {
+        vector<double> methodThresholds = thresholds.empty() ? vector<double>(1, Utils::getDefaultThreshold(method)) : thresholds;
+        for (double sweepThreshold : methodThresholds) {
+            for (int blockSize : blockSizes) {
+                if (outputPaths.insert(Utils::getDefaultOutputPath(inputPath, method, sweepThreshold, blockSize)).second) {
+                    tuner.addCandidate(method, sweepThreshold, blockSize);
+                }
+            }
+        }
+    }
+
+    // Output ditulis dari worker thread; paralelisme ada di tingkat kombinasi, jadi encoder memakai satu thread
+    tuner.setTreeHandler([this](AutoTuner::Candidate& candidate, const QuadTree& tree, const unsigned char* pixels) {
+        candidate.outputPath = Utils::getDefaultOutputPath(inputPath, candidate.method, candidate.threshold,
+                                                           candidate.minBlockSize);
+        size_t separator = candidate.outputPath.find_last_of("/\\");
+        if (separator != string::npos && separator > 0) {
+            Utils::createDirectoryIfNotExists(candidate.outputPath.substr(0, separator));
+        }
+        if (saveTree(tree, candidate.outputPath, 1, pixels)) {
+            candidate.outputSize = Utils::getFileSize(candidate.outputPath);
+        } else {
+            candidate.evaluated = false;
+        }
+    });
+
+    std::cout << "Sweeping " << tuner.getCandidates().size() << " parameter combinations..." << std::endl;
+    tuner.run();
+
+    int failures = 0;
+    for (const AutoTuner::Candidate& candidate : tuner.getCandidates()) {
+        if (!candidate.evaluated) {
+            std::cerr << "Error: Sweep combination " << Utils::errorMetricToString(candidate.method)
+                      << ", threshold " << candidate.threshold << ", min block " << candidate.minBlockSize
+                      << " failed" << std::endl;
+            failures++;
+        }
+    }
+    if (!tuner.writeCsv(csvPath)) {
+        return false;
+    }
+    std::cout << "Sweep completed: " << (tuner.getCandidates().size() - failures) << " of "
+              << tuner.getCandidates().size() << " combinations in " << tuner.getElapsedMs() << " ms" << std::endl;
+    std::cout << "Sweep results written to " << csvPath << std::endl;
+    return failures == 0;
+}
+
 // Menyimpan gambar hasil kompresi
 bool ImageProcessor::saveCompressedImage() {
     // Validasi
-    if (compressedImage.empty() || compressedImage[0].empty()) {
+    if (!quadTree && !planarTree) {
         std::cerr << "Error: No compressed image to save" << std::endl;
         return false;
     }
     
-    // Prepare data untuk stb_image_write
-    unsigned char* data = new unsigned char[width * height * 3]; // Always save as RGB
+    // Format native dan SVG menyimpan tree itu sendiri, bukan gambar hasil rasterisasi
+    if (isTreeOutput(outputPath)) {
+        if (!quadTree) {
+            std::cerr << "Error: ." << Utils::getFileExtension(outputPath)
+                      << " output requires a single joint tree (--channels joint)" << std::endl;
+            return false;
+        }
+        return writeTreeFile(*quadTree, outputPath);
+    }
     
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int idx = (y * width + x) * 3;
-            data[idx] = compressedImage[y][x].getRed();
-            data[idx + 1] = compressedImage[y][x].getGreen();
-            data[idx + 2] = compressedImage[y][x].getBlue();
+    if (isBandOutput(outputPath)) {
+        return saveBands(outputPath, threadCount, [this](unsigned char* band, int firstRow, int lastRow) {
+            if (quadTree) {
+                quadTree->rasterizeRows(band, 3, firstRow, lastRow);
+            } else {
+                planarTree->rasterizeRows(band, 3, firstRow, lastRow);
+            }
+        });
+    }
+    
+    // Tree sudah dirasterisasi langsung ke buffer indeks atau buffer RGB yang dipakai encoder
+    if (!compressedPalette.empty()) {
+        return writeIndexedRaster(outputPath, compressedIndices.data(), compressedPalette, threadCount);
+    }
+    return writeRaster(outputPath, compressedPixels.data(), threadCount);
+}
+
+// Menyimpan tree apa pun (bukan tree milik processor) ke path tertentu, dipakai sweep.
+// Jika raster sudah tersedia, output raster dan band diambil darinya tanpa merender ulang
+bool ImageProcessor::saveTree(const QuadTree& tree, const string& path, int threads,
+                              const unsigned char* pixels) const {
+    if (isTreeOutput(path)) {
+        return writeTreeFile(tree, path);
+    }
+    size_t rowBytes = static_cast<size_t>(width) * 3;
+    if (isBandOutput(path)) {
+        return saveBands(path, threads, [&](unsigned char* band, int firstRow, int lastRow) {
+            if (pixels) {
+                std::memcpy(band, pixels + firstRow * rowBytes, (lastRow - firstRow) * rowBytes);
+            } else {
+                tree.rasterizeRows(band, 3, firstRow, lastRow);
+            }
+        });
+    }
+    vector<RGB> palette;
+    if (findOutputPalette(path, tree, palette)) {
+        vector<unsigned char> indices(static_cast<size_t>(width) * height);
+        if (pixels) {
+            indexPixels(pixels, indices.size(), palette, indices.data());
+        } else {
+            tree.rasterizeIndices(indices.data(), palette);
         }
+        return writeIndexedRaster(path, indices.data(), palette, threads);
+    }
+    if (pixels) {
+        return writeRaster(path, pixels, threads);
     }
+    vector<unsigned char> rendered(rowBytes * height);
+    tree.rasterize(rendered.data(), 3);
+    return writeRaster(path, rendered.data(), threads);
+}
+
+size_t ImageProcessor::measureOutputSize(const QuadTree& tree, const string& path,
+                                         const unsigned char* pixels) const {
+    string ext = Utils::getFileExtension(path);
+    vector<unsigned char> encoded;
+    bool success = false;
     
+    if (ext == "qtc") {
+        success = QtcCodec::encode(tree, encoded);
+    } else if (ext == "qtp") {
+        success = QtcCodec::encodeProgressive(tree, encoded, maxOutputBytes);
+    } else if (ext == "qti") {
+        return sizeof(TreeIndex::Header) + static_cast<size_t>(tree.getNodeCount()) * sizeof(TreeIndex::IndexNode);
+    } else if (ext == "svg" || ext == "svgz") {
+        string svg = SvgWriter::toSvg(tree);
+        if (ext == "svg") {
+            return svg.size();
+        }
+        Deflate::gzip(reinterpret_cast<const unsigned char*>(svg.data()), svg.size(), encoded);
+        success = true;
+    } else if (ext == "ppm") {
+        string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+        return header.size() + static_cast<size_t>(width) * height * 3;
+    } else if (ext == "jpg" || ext == "jpeg" || ext == "bmp") {
+        auto append = [](void* context, void* data, int size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            static_cast<vector<unsigned char>*>(context)->insert(
+                static_cast<vector<unsigned char>*>(context)->end(), bytes, bytes + size);
+        };
+        success = (ext == "bmp") ? stbi_write_bmp_to_func(append, &encoded, width, height, 3, pixels)
+                                 : stbi_write_jpg_to_func(append, &encoded, width, height, 3, pixels, jpegQuality);
+    } else if (ext == "qoi") {
+        success = QoiCodec::encode(width, height, 3, pixels, encoded);
+    } else {
+        // PNG; output per band memakai encoder PNG yang sama dengan pembagian segmen berbeda
+        vector<RGB> palette;
+        if (!isBandOutput(path) && findOutputPalette(path, tree, palette)) {
+            vector<unsigned char> indices(static_cast<size_t>(width) * height);
+            indexPixels(pixels, indices.size(), palette, indices.data());
+            success = PngWriter::encodeIndexed(width, height, indices.data(), palette, encoded, 1);
+        } else {
+            success = PngWriter::encode(width, height, 3, pixels, encoded, 1);
+        }
+    }
+    return success ? encoded.size() : 0;
+}
+
+bool ImageProcessor::writeTreeFile(const QuadTree& tree, const string& path) const {
+    string treeExt = Utils::getFileExtension(path);
+    bool encoded = false;
+    if (treeExt == "qtc") {
+        encoded = QtcCodec::encodeToFile(tree, path);
+    } else if (treeExt == "qtp") {
+        encoded = QtcCodec::encodeProgressiveToFile(tree, path, maxOutputBytes);
+    } else if (treeExt == "qti") {
+        encoded = TreeIndex::write(tree, path);
+    } else {
+        encoded = SvgWriter::write(tree, path, treeExt == "svgz");
+    }
+    if (!encoded) {
+        std::cerr << "Error: Failed to save compressed image to " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// PNG (juga format default) ditulis indexed jika warna leaf muat di palet
+bool ImageProcessor::findOutputPalette(const string& path, const QuadTree& tree, vector<RGB>& palette) const {
+    palette.clear();
+    string ext = Utils::getFileExtension(path);
+    if (ext == "jpg" || ext == "jpeg" || ext == "bmp" || ext == "qoi") {
+        return false;
+    }
+    if (!tree.getLeafPalette(palette, 256)) {
+        palette.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ImageProcessor::writeRaster(const string& path, const unsigned char* data, int threads) const {
     // Tentukan format output berdasarkan ekstensi file
     bool success = false;
-    string ext = Utils::getFileExtension(outputPath);
+    string ext = Utils::getFileExtension(path);
     
     if (ext == "jpg" || ext == "jpeg") {
-        success = stbi_write_jpg(outputPath.c_str(), width, height, 3, data, 90); // quality 90
-    } else if (ext == "png") {
-        success = stbi_write_png(outputPath.c_str(), width, height, 3, data, width * 3);
+        success = stbi_write_jpg(path.c_str(), width, height, 3, data, jpegQuality);
     } else if (ext == "bmp") {
-        success = stbi_write_bmp(outputPath.c_str(), width, height, 3, data);
+        success = stbi_write_bmp(path.c_str(), width, height, 3, data);
+    } else if (ext == "qoi") {
+        success = QoiCodec::encodeToFile(path, width, height, 3, data);
     } else {
-        // Default to PNG
-        success = stbi_write_png(outputPath.c_str(), width, height, 3, data, width * 3);
+        // PNG (juga default) dengan warna leaf yang tidak muat di palet
+        success = PngWriter::write(path, width, height, 3, data, threads);
     }
     
-    delete[] data;
-    
     if (!success) {
-        std::cerr << "Error: Failed to save compressed image to " << outputPath << std::endl;
+        std::cerr << "Error: Failed to save compressed image to " << path << std::endl;
         return false;
     }
     
     return true;
 }
+
+bool ImageProcessor::writeIndexedRaster(const string& path, const unsigned char* indices,
+                                        const vector<RGB>& palette, int threads) const {
+    if (!PngWriter::writeIndexed(path, width, height, indices, palette, threads)) {
+        std::cerr << "Error: Failed to save compressed image to " << path << std::endl;
+        return false;
+    }
+    return true;
+}
 // Menampilkan semua metrik hasil kompresi
 void ImageProcessor::displayMetrics() const {
     std::cout << "\n=== Compression Results ===" << std::endl;
     
     // Informasi tentang threshold dan metode
     std::cout << "Error metric     : " << Utils::errorMetricToString(errorMetricType) << std::endl;
+    if (leafModel != LeafModel::FLAT) {
+        std::cout << "Leaf model       : " << Utils::leafModelToString(leafModel) << std::endl;
+    }
+    if (partitionMode != QuadTree::QUADRANT) {
+        std::cout << "Partition        : " << Utils::partitionModeToString(partitionMode) << std::endl;
+    }
+    if (jpegGrid > 0) {
+        std::cout << "Split grid       : " << jpegGrid << "x" << jpegGrid << " pixels" << std::endl;
+    }
+    if (isBandOutput(outputPath)) {
+        std::cout << "Output bands     : " << (bandHeight > 0 ? std::min(bandHeight, height) : height)
+                  << " rows" << std::endl;
+    }
+    if (channelMode != PlanarQuadTree::JOINT) {
+        std::cout << "Channel trees    : "
+                  << (channelMode == PlanarQuadTree::YCBCR_PLANES ? "Y/Cb/Cr" : "R/G/B");
+        if (planarTree) {
+            std::cout << " (" << planarTree->getPlane(0).getNodeCount() << "/"
+                      << planarTree->getPlane(1).getNodeCount() << "/"
+                      << planarTree->getPlane(2).getNodeCount() << " nodes)";
+        }
+        std::cout << std::endl;
+    }
     
     if (targetCompressionPercentage > 0.0) {
-        std::cout << "Target compression: " << std::fixed << std::setprecision(1) 
-                  << (targetCompressionPercentage * 100) << "%" << std::endl;
+        // Angka diformat di stream lokal agar state format std::cout tidak ikut berubah
+        std::ostringstream target;
+        target << std::fixed << std::setprecision(1) << (targetCompressionPercentage * 100) << "%";
+        std::cout << "Target compression: " << target.str() << std::endl;
         std::cout << "Final threshold  : " << threshold << std::endl;
     } else {
         std::cout << "Threshold        : " << threshold << std::endl;
@@ -217,8 +672,9 @@ void ImageProcessor::displayMetrics() const {
     std::cout << "Compressed size  : " << actualCompressedSize << " bytes" << std::endl;
     
     double actualCompression = 100.0 * (1.0 - static_cast<double>(actualCompressedSize) / originalSize);
-    std::cout << "Compression      : " << std::fixed << std::setprecision(2) 
-              << actualCompression << "%" << std::endl;
+    std::ostringstream compression;
+    compression << std::fixed << std::setprecision(2) << actualCompression << "%";
+    std::cout << "Compression      : " << compression.str() << std::endl;
     
     // Statistik QuadTree
     std::cout << "Min block size   : " << minBlockSize << " pixels" << std::endl;
@@ -260,6 +716,91 @@ size_t ImageProcessor::getCompressedSize() const {
     return compressedSize;
 }
 
+// Format yang ditulis langsung dari tree tidak membutuhkan gambar hasil rasterisasi
+bool ImageProcessor::isTreeOutput(const string& path) const {
+    string ext = Utils::getFileExtension(path);
+    return ext == "qtc" || ext == "qtp" || ext == "qti" || ext == "svg" || ext == "svgz";
+}
+
+// PPM selalu ditulis per band karena tidak ada writer lain untuk format tersebut
+bool ImageProcessor::isBandOutput(const string& path) const {
+    string ext = Utils::getFileExtension(path);
+    return ext == "ppm" || (bandHeight > 0 && BandWriter::supports(ext));
+}
+
+// Hanya satu band yang ada di memori: render baris [y, y + band), tulis, lalu lanjut
+bool ImageProcessor::saveBands(const string& path, int threads,
+                               const function<void(unsigned char*, int, int)>& renderRows) const {
+    BandWriter writer;
+    if (!writer.open(path, width, height, threads)) {
+        return false;
+    }
+    int rowsPerBand = bandHeight > 0 ? std::min(bandHeight, height) : height;
+    vector<unsigned char> band(static_cast<size_t>(width) * rowsPerBand * 3);
+    for (int firstRow = 0; firstRow < height; firstRow += rowsPerBand) {
+        int lastRow = std::min(height, firstRow + rowsPerBand);
+        renderRows(band.data(), firstRow, lastRow);
+        if (!writer.writeRows(band.data(), lastRow - firstRow)) {
+            std::cerr << "Error: Failed to save compressed image to " << path << std::endl;
+            return false;
+        }
+    }
+    if (!writer.close()) {
+        std::cerr << "Error: Failed to save compressed image to " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Membuat QuadTree dengan seluruh pengaturan processor
+unique_ptr<QuadTree> ImageProcessor::createQuadTree(double treeThreshold) const {
+    unique_ptr<QuadTree> tree = make_unique<QuadTree>(statistics, minBlockSize, treeThreshold, errorMetricType);
+    tree->setImportanceMap(importanceMap);
+    tree->setLeafModel(leafModel);
+    tree->setPartitionMode(partitionMode);
+    tree->setSplitGrid(jpegGrid);
+    return tree;
+}
+
+// Membuat PlanarQuadTree dengan seluruh pengaturan processor
+unique_ptr<PlanarQuadTree> ImageProcessor::createPlanarQuadTree(double treeThreshold) const {
+    unique_ptr<PlanarQuadTree> tree = make_unique<PlanarQuadTree>(statistics->getImage(), channelMode, minBlockSize,
+                                                                  treeThreshold, errorMetricType, threadCount);
+    tree->setImportanceMap(importanceMap);
+    tree->setLeafModel(leafModel);
+    tree->setPartitionMode(partitionMode);
+    tree->setSplitGrid(jpegGrid);
+    return tree;
+}
+
+// Memuat peta kepentingan dari mask grayscale dan/atau region ROI
+bool ImageProcessor::loadImportanceMap() {
+    if (roiMaskPath.empty() && roiRegions.empty()) {
+        return true;
+    }
+    
+    unsigned char* mask = nullptr;
+    int maskWidth = 0, maskHeight = 0, maskChannels = 0;
+    if (!roiMaskPath.empty()) {
+        mask = stbi_load(roiMaskPath.c_str(), &maskWidth, &maskHeight, &maskChannels, 1);
+        if (!mask) {
+            std::cerr << "Error: Failed to load ROI mask - " << roiMaskPath << std::endl;
+            return false;
+        }
+    }
+    
+    importanceMap = make_shared<ImportanceMap>(width, height, mask, maskWidth, maskHeight,
+                                               roiRegions, roiStrength);
+    if (mask) {
+        stbi_image_free(mask);
+    }
+    
+    std::cout << "ROI importance map loaded";
+    if (!roiMaskPath.empty()) std::cout << " from " << roiMaskPath;
+    std::cout << " (" << roiRegions.size() << " regions, strength " << roiStrength << ")" << std::endl;
+    return true;
+}
+
 // Mencari threshold yang sesuai untuk target persentase kompresi
 double ImageProcessor::findThresholdForTargetCompression() {
     // Inisialisasi nilai batas atas dan bawah untuk binary search
@@ -285,11 +826,17 @@ double ImageProcessor::findThresholdForTargetCompression() {
         currentThreshold = (lowerBound + upperBound) / 2.0;
         
         // Buat QuadTree dengan threshold ini untuk pengujian
-        QuadTree testTree(originalImage, minBlockSize, currentThreshold, errorMetricType);
-        testTree.buildTree();
-        
         // Hitung persentase kompresi yang dicapai dengan threshold ini
-        double achievedCompression = testTree.getCompressionPercentage();
+        double achievedCompression;
+        if (channelMode != PlanarQuadTree::JOINT) {
+            unique_ptr<PlanarQuadTree> testTree = createPlanarQuadTree(currentThreshold);
+            testTree->buildTree();
+            achievedCompression = testTree->getCompressionPercentage();
+        } else {
+            unique_ptr<QuadTree> testTree = createQuadTree(currentThreshold);
+            testTree->buildTree();
+            achievedCompression = testTree->getCompressionPercentage();
+        }
         
         // Hitung perbedaan dengan target
         double difference = std::fabs(achievedCompression - targetCompressionPercentage);
@@ -328,98 +875,214 @@ double ImageProcessor::findThresholdForTargetCompression() {
 }
 
 
-bool ImageProcessor::generateCompressionGif() {
+bool ImageProcessor::generateCompressionAnimation() {
     try {
-      
-        std::string directory = gifPath.substr(0, gifPath.find_last_of("/\\"));
-        if (!directory.empty()) {
-            Utils::createDirectoryIfNotExists(directory);
+        bool writeGif = !gifPath.empty();
+        bool writeVideo = !videoPath.empty();
+        size_t separator = gifPath.find_last_of("/\\");
+        if (writeGif && separator != std::string::npos && separator > 0) {
+            Utils::createDirectoryIfNotExists(gifPath.substr(0, separator));
         }
 
+        const vector<QuadTree::SplitEvent>& splitLog = quadTree->getSplitLog();
+        const Node* root = quadTree->getRoot();
 
-        GifWriter gifWriter;
-        if (!GifBegin(&gifWriter, gifPath.c_str(), width, height, 10)) {
-            std::cerr << "Failed to initialize GIF writer\n";
-            return false;
+        // Palet global: semua warna animasi adalah warna node, jadi palet dibangun sekali dari log split
+        GifPipeline pipeline;
+        bool indexedGif = writeGif && gifGlobalPalette;
+        if (indexedGif) {
+            vector<RGB> colors;
+            colors.reserve(splitLog.size() * 4 + 1);
+            colors.push_back(root->getAvgColor());
+            for (const QuadTree::SplitEvent& event : splitLog) {
+                for (int quadrant = 0; quadrant < 4; quadrant++) {
+                    if (event.region.getQuadrant(quadrant, event.splitX, event.splitY).getArea() > 0) {
+                        colors.push_back(event.childColors[quadrant]);
+                    }
+                }
+            }
+            pipeline.setGlobalPalette(colors);
         }
 
-        std::cout << "Generating GIF (streaming)...\n";
-
-   
-        std::vector<std::vector<RGB>> gifBuffer = originalImage;
+        // Kanvas animasi dapat diperkecil; region tree dipetakan langsung ke koordinat terskala
+        int canvasWidth = width, canvasHeight = height;
+        if (gifMaxDimension > 0 && std::max(width, height) > gifMaxDimension) {
+            double scale = static_cast<double>(gifMaxDimension) / std::max(width, height);
+            canvasWidth = std::max(1, static_cast<int>(std::lround(width * scale)));
+            canvasHeight = std::max(1, static_cast<int>(std::lround(height * scale)));
+        }
+        auto toCanvas = [&](const Block& region) {
+            return region.scaled(width, height, canvasWidth, canvasHeight);
+        };
 
-   
-        int frameCounter = 0;
-        const int frameInterval = 100;  
+        if (writeGif && !pipeline.open(gifPath, canvasWidth, canvasHeight, 10, threadCount)) {
+            std::cerr << "Failed to initialize GIF writer\n";
+            return false;
+        }
+        FrameStreamWriter stream;
+        if (writeVideo && !stream.open(videoPath, videoFormat, canvasWidth, canvasHeight, 10)) {
+            std::cerr << "Failed to initialize frame stream\n";
+            return false;
+        }
 
+        // Replay log split dari build utama: mulai dari warna root, setiap split mengecat region anak.
+        // Frame GIF diserahkan ke pipeline; palet, kuantisasi dan LZW dikerjakan worker thread secara paralel
+        std::cout << "Generating animation from " << splitLog.size() << " recorded splits"
+                  << (indexedGif ? " with a global GIF palette" : "") << "...\n";
 
-        auto callback = [&](const Block& region, const RGB& avgColor) {
-    
-            for (int y = region.getY(); y < region.getY() + region.getHeight(); ++y) {
-                for (int x = region.getX(); x < region.getX() + region.getWidth(); ++x) {
-                    gifBuffer[y][x] = avgColor;
+        // Kanvas RGBA untuk GIF palet per frame dan stream video, kanvas index untuk GIF palet global
+        const int splitsPerFrame = 100;
+        size_t pixelCount = static_cast<size_t>(canvasWidth) * canvasHeight;
+        std::vector<uint8_t> rgbaCanvas((writeGif && !indexedGif) || writeVideo ? pixelCount * 4 : 0);
+        std::vector<uint8_t> indexCanvas(indexedGif ? pixelCount : 0);
+        auto fillRegion = [&](const Block& region, const RGB& color) {
+            if (region.getArea() <= 0) {
+                return;
+            }
+            size_t firstPixel = region.getY() * static_cast<size_t>(canvasWidth) + region.getX();
+            if (!rgbaCanvas.empty()) {
+                size_t rowStride = static_cast<size_t>(canvasWidth) * 4;
+                size_t spanBytes = static_cast<size_t>(region.getWidth()) * 4;
+                uint8_t* first = &rgbaCanvas[firstPixel * 4];
+                for (uint8_t* pixel = first; pixel < first + spanBytes; pixel += 4) {
+                    pixel[0] = color.getRed();
+                    pixel[1] = color.getGreen();
+                    pixel[2] = color.getBlue();
+                    pixel[3] = 255;
+                }
+                for (int y = 1; y < region.getHeight(); y++) {
+                    std::memcpy(first + y * rowStride, first, spanBytes);
                 }
             }
-
-        
-            if (frameCounter % frameInterval == 0) {
-                std::vector<uint8_t> frameData(width * height * 4);
-                for (int y = 0; y < height; ++y) {
-                    for (int x = 0; x < width; ++x) {
-                        int idx = (y * width + x) * 4;
-                        const RGB& pixel = gifBuffer[y][x];
-                        frameData[idx + 0] = pixel.getRed();
-                        frameData[idx + 1] = pixel.getGreen();
-                        frameData[idx + 2] = pixel.getBlue();
-                        frameData[idx + 3] = 255;
-                    }
+            if (!indexCanvas.empty()) {
+                uint8_t index = pipeline.getColorIndex(color);
+                for (int y = 0; y < region.getHeight(); y++) {
+                    std::memset(&indexCanvas[firstPixel + y * static_cast<size_t>(canvasWidth)], index, region.getWidth());
                 }
-                std::cout << "Callback triggered at frameCounter = " << frameCounter << std::endl;
-                GifWriteFrame(&gifWriter, frameData.data(), width, height, 10);
-                std::cout << "Frame " << (frameCounter / frameInterval) << " written\n";
             }
+        };
+
+        // Setiap frame hanya mengodekan (GIF) atau mengonversi (stream) persegi panjang yang berubah
+        int dirtyLeft = canvasWidth, dirtyTop = canvasHeight, dirtyRight = 0, dirtyBottom = 0;
+        bool submitted = true;
+        auto markDirty = [&](const Block& region) {
+            if (region.getArea() <= 0) {
+                return;
+            }
+            dirtyLeft = std::min(dirtyLeft, region.getX());
+            dirtyTop = std::min(dirtyTop, region.getY());
+            dirtyRight = std::max(dirtyRight, region.getX() + region.getWidth());
+            dirtyBottom = std::max(dirtyBottom, region.getY() + region.getHeight());
+        };
+        auto writeFrame = [&]() {
+            if (dirtyLeft >= dirtyRight || dirtyTop >= dirtyBottom) {
+                return;
+            }
+            int dirtyWidth = dirtyRight - dirtyLeft, dirtyHeight = dirtyBottom - dirtyTop;
+            if (writeGif) {
+                submitted = pipeline.submitFrame(indexedGif ? indexCanvas.data() : rgbaCanvas.data(),
+                                                 dirtyLeft, dirtyTop, dirtyWidth, dirtyHeight) && submitted;
+            }
+            if (writeVideo) {
+                submitted = stream.writeFrame(rgbaCanvas.data(), dirtyLeft, dirtyTop, dirtyWidth, dirtyHeight) && submitted;
+            }
+            dirtyLeft = canvasWidth;
+            dirtyTop = canvasHeight;
+            dirtyRight = dirtyBottom = 0;
+        };
 
-            frameCounter++;
+        // Urutan replay dan batas frame (jumlah split yang sudah dicat sebelum frame ditulis).
+        // Mode per level dan jumlah frame tetap me-replay split urut kedalaman, dari kasar ke halus
+        size_t splitCount = splitLog.size();
+        vector<size_t> order(splitCount);
+        vector<size_t> frameEnds;
+        if (gifPerLevel || gifFrameCount > 0) {
+            int deepest = 0;
+            for (const QuadTree::SplitEvent& event : splitLog) {
+                deepest = std::max(deepest, event.depth);
+            }
+            vector<size_t> levelStart(deepest + 2, 0);
+            for (const QuadTree::SplitEvent& event : splitLog) {
+                levelStart[event.depth + 1]++;
+            }
+            for (int depth = 0; depth <= deepest; depth++) {
+                levelStart[depth + 1] += levelStart[depth];
+            }
+            vector<size_t> position(levelStart.begin(), levelStart.end() - 1);
+            for (size_t i = 0; i < splitCount; i++) {
+                order[position[splitLog[i].depth]++] = i;
+            }
 
-            Sleep(1);
+            if (gifPerLevel) {
+                frameEnds.assign(levelStart.begin(), levelStart.end());
+            } else if (gifFrameCount == 1) {
+                frameEnds.push_back(splitCount);
+            } else {
+                for (int frame = 0; frame < gifFrameCount; frame++) {
+                    frameEnds.push_back(splitCount * frame / (gifFrameCount - 1));
+                }
+            }
+        } else {
+            for (size_t i = 0; i < splitCount; i++) {
+                order[i] = i;
+            }
+            for (size_t end = 0; end < splitCount; end += splitsPerFrame) {
+                frameEnds.push_back(end);
+            }
+            frameEnds.push_back(splitCount);
+        }
 
-        };
+        fillRegion(toCanvas(root->getRegion()), root->getAvgColor());
+        markDirty(toCanvas(root->getRegion()));
 
-        QuadTree treeCopy(originalImage, minBlockSize, threshold, errorMetricType);
-        treeCopy.setCompressionRegionCallback(callback);  
-        treeCopy.buildTree();
+        size_t applied = 0;
+        for (size_t frame = 0; frame < frameEnds.size(); frame++) {
+            for (; applied < frameEnds[frame]; applied++) {
+                const QuadTree::SplitEvent& event = splitLog[order[applied]];
+                for (int quadrant = 0; quadrant < 4; quadrant++) {
+                    fillRegion(toCanvas(event.region.getQuadrant(quadrant, event.splitX, event.splitY)), event.childColors[quadrant]);
+                }
+                markDirty(toCanvas(event.region));
+            }
 
-            
-        std::vector<uint8_t> finalFrame(width * height * 4);
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                int idx = (y * width + x) * 4;
-                const RGB& pixel = compressedImage[y][x];
-                finalFrame[idx + 0] = pixel.getRed();
-                finalFrame[idx + 1] = pixel.getGreen();
-                finalFrame[idx + 2] = pixel.getBlue();
-                finalFrame[idx + 3] = 255;
+            // Leaf flat sudah tergambar oleh replay; leaf model dirasterisasi penuh untuk frame terakhir
+            if (frame + 1 == frameEnds.size() && leafModel != LeafModel::FLAT) {
+                if (!indexCanvas.empty()) {
+                    std::vector<uint8_t> pixels(pixelCount * 3);
+                    quadTree->rasterizeScaled(pixels.data(), 3, canvasWidth, canvasHeight);
+                    pipeline.mapColors(pixels.data(), pixelCount, indexCanvas.data());
+                }
+                if (!rgbaCanvas.empty()) {
+                    quadTree->rasterizeScaled(rgbaCanvas.data(), 4, canvasWidth, canvasHeight);
+                }
+                markDirty(toCanvas(root->getRegion()));
             }
+            writeFrame();
         }
-        GifWriteFrame(&gifWriter, finalFrame.data(), width, height, 10);
-        std::cout << "Final frame written\n";
 
-        GifEnd(&gifWriter);
-        std::cout << "GIF created successfully at " << gifPath << std::endl;
-        return true;
+        bool success = submitted;
+        if (writeGif) {
+            if (pipeline.close()) {
+                std::cout << "GIF created successfully at " << gifPath << " (" << pipeline.getFrameCount() << " frames)" << std::endl;
+            } else {
+                std::cerr << "Failed to write GIF " << gifPath << std::endl;
+                success = false;
+            }
+        }
+        if (writeVideo) {
+            if (stream.close()) {
+                std::cout << "Frame stream written to " << (videoPath == "-" ? "stdout" : videoPath)
+                          << " (" << stream.getFrameCount() << " frames)" << std::endl;
+            } else {
+                std::cerr << "Failed to write frame stream " << videoPath << std::endl;
+                success = false;
+            }
+        }
+        return success;
     }
     catch (const std::exception& e) {
-        std::cerr << "Compression GIF generation error: " << e.what() << std::endl;
+        std::cerr << "Compression animation error: " << e.what() << std::endl;
         return false;
     }
 }
 
-
-size_t ImageProcessor::calculateImageSize(const vector<vector<RGB>>& img) const {
-    if (img.empty() || img[0].empty()) {
-        return 0;
-    }
-    
-    // Perkiraan kasar: 3 byte per piksel (RGB) + overhead
-    return img.size() * img[0].size() * 3;
-}
\ No newline at end of file
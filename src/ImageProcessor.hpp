@@ -5,7 +5,13 @@
 #include <chrono>
 #include <vector>
 #include <memory>
+#include <functional>
 #include "QuadTree.hpp"
+#include "ImageStatistics.hpp"
+#include "AutoTuner.hpp"
+#include "ImportanceMap.hpp"
+#include "PlanarQuadTree.hpp"
+#include "FrameStreamWriter.hpp"
 #include "RGB.hpp"
 
 
@@ -22,8 +28,10 @@ private:
     string gifPath;             
     
     int width, height, channels;     // Dimensi dan jumlah channel gambar
-    vector<vector<RGB>> originalImage;    
-    vector<vector<RGB>> compressedImage;  
+    vector<unsigned char> compressedPixels; // Hasil kompresi, RGB interleaved siap untuk encoder
+    vector<unsigned char> compressedIndices; // Hasil kompresi sebagai indeks palet (PNG indexed)
+    vector<RGB> compressedPalette;          // Palet untuk compressedIndices, kosong jika output RGB
+    shared_ptr<ImageStatistics> statistics; // Gambar original beserta statistiknya, dibuat sekali saat load
     
     int minBlockSize;                
     double threshold;                      
@@ -31,6 +39,21 @@ private:
     double targetCompressionPercentage;    
     
     unique_ptr<QuadTree> quadTree;         // QuadTree untuk kompresi
+    PlanarQuadTree::ChannelMode channelMode;  // Satu tree gabungan atau tree per channel
+    unique_ptr<PlanarQuadTree> planarTree; // Tree per channel (jika channelMode != JOINT)
+    int threadCount;                       // Worker thread untuk mode paralel
+    LeafModel::Type leafModel;             // Prediktor warna leaf node
+    QuadTree::PartitionMode partitionMode; // Posisi potongan titik tengah atau adaptif
+    size_t maxOutputBytes;                 // Batas ukuran output progresif .qtp (0 = tanpa batas)
+    int jpegGrid;                          // Grid MCU untuk posisi potongan (0 = nonaktif)
+    int jpegQuality;                       // Kualitas output JPEG (1-100)
+    int bandHeight;                        // Tinggi band output streaming (0 = satu buffer penuh)
+    bool gifGlobalPalette;                 // GIF memakai satu palet global dari warna node tree
+    int gifFrameCount;                     // Jumlah frame GIF merata (0 = satu frame per 100 split)
+    bool gifPerLevel;                      // Satu frame GIF per kedalaman tree
+    int gifMaxDimension;                   // Sisi terpanjang kanvas GIF (0 = resolusi penuh)
+    string videoPath;                      // Stream frame mentah (kosong = tidak ada, "-" = stdout)
+    FrameStreamWriter::Format videoFormat; // Format stream frame mentah
     
     // Metrik hasil kompresi
     double compressionPercentage;
@@ -40,6 +63,12 @@ private:
     size_t originalSize;
     size_t compressedSize;
     
+    // Region of interest untuk threshold per region
+    string roiMaskPath;
+    vector<Block> roiRegions;
+    double roiStrength;
+    shared_ptr<ImportanceMap> importanceMap;
+    
 public:
     /**
      * @brief Constructor untuk ImageProcessor
@@ -58,12 +87,128 @@ public:
                    const string& = "");
     
     bool loadImage();
+
+    /**
+     * @brief Menetapkan mask grayscale region of interest (putih = penting)
+     * @param Path gambar mask
+     */
+    void setRoiMask(const string&);
+
+    /**
+     * @brief Menambahkan region persegi yang dianggap penting
+     * @param Region penting
+     */
+    void addRoiRegion(const Block&);
+
+    /**
+     * @brief Menetapkan kekuatan skala threshold ROI
+     * @param Faktor k (threshold x1/k pada region penting, xk pada latar)
+     */
+    void setRoiStrength(double);
+
+    /**
+     * @brief Menetapkan mode channel (tree gabungan atau tree terpisah per channel)
+     * @param Mode channel
+     */
+    void setChannelMode(PlanarQuadTree::ChannelMode);
+
+    /**
+     * @brief Menetapkan jumlah worker thread untuk mode paralel
+     * @param Jumlah thread (0 = jumlah core)
+     */
+    void setThreadCount(int);
+
+    /**
+     * @brief Menetapkan jenis leaf model (flat, planar, bilinear)
+     * @param Tipe leaf model
+     */
+    void setLeafModel(LeafModel::Type);
+
+    /**
+     * @brief Menetapkan mode partisi (titik tengah, biner adaptif, atau quad adaptif)
+     * @param Mode partisi
+     */
+    void setPartitionMode(QuadTree::PartitionMode);
+
+    /**
+     * @brief Menetapkan batas ukuran file untuk output progresif .qtp
+     * @param Batas dalam byte (0 = tanpa batas)
+     */
+    void setMaxOutputBytes(size_t);
+
+    /**
+     * @brief Menyelaraskan potongan tree ke grid MCU JPEG agar block datar tidak memotong block DCT
+     * @param Ukuran grid, 8 atau 16 (0 = nonaktif)
+     */
+    void setJpegGrid(int);
+
+    /**
+     * @brief Menetapkan kualitas output JPEG
+     * @param Kualitas (1-100)
+     */
+    void setJpegQuality(int);
+
+    /**
+     * @brief Menulis output per band baris sehingga buffer output tidak pernah sebesar gambar
+     * @param Tinggi band dalam baris (0 = nonaktif)
+     */
+    void setBandHeight(int);
+
+    /**
+     * @brief Membangun satu palet global GIF dari warna node tree, bukan palet per frame
+     * @param true untuk palet global
+     */
+    void setGifGlobalPalette(bool);
+
+    /**
+     * @brief Membatasi animasi GIF pada sejumlah frame yang tersebar merata dari kasar ke halus
+     * @param Jumlah frame (0 = satu frame per 100 split)
+     */
+    void setGifFrameCount(int);
+
+    /**
+     * @brief Membuat satu frame GIF per kedalaman tree
+     * @param true untuk satu frame per level
+     */
+    void setGifPerLevel(bool);
+
+    /**
+     * @brief Membatasi sisi terpanjang kanvas GIF; frame dirender langsung dari tree pada resolusi itu
+     * @param Sisi terpanjang dalam piksel (0 = resolusi penuh)
+     */
+    void setGifMaxDimension(int);
+
+    /**
+     * @brief Menulis animasi kompresi sebagai stream frame mentah (YUV4MPEG2 atau PPM) selain/alih-alih GIF
+     * @param Path output ("-" untuk stdout, kosong untuk menonaktifkan)
+     * @param Format stream
+     */
+    void setVideoOutput(const string&, FrameStreamWriter::Format);
     
     /**
      * @brief Melakukan kompresi gambar
      * @return true jika berhasil, false jika gagal
      */
     bool compressImage();
+
+    /**
+     * @brief Mencari parameter kompresi secara paralel di atas statistik gambar yang sama
+     * @param Jenis goal (NO_GOAL hanya menampilkan Pareto front)
+     * @param Nilai target goal
+     * @return true jika parameter terpilih sudah diterapkan untuk kompresi
+     */
+    bool autoTune(AutoTuner::GoalType, double);
+
+    /**
+     * @brief Membangun dan menyimpan setiap kombinasi metode x threshold x ukuran blok secara paralel
+     *        di atas statistik gambar yang sama, lalu menulis CSV hasilnya. Output memakai penamaan default
+     * @param Daftar metrik error
+     * @param Daftar threshold (kosong = threshold default setiap metrik)
+     * @param Daftar ukuran blok minimum
+     * @param Path file CSV
+     * @return true jika semua kombinasi berhasil dan CSV tertulis
+     */
+    bool sweep(const vector<QuadTree::ErrorMetricType>&, const vector<double>&, const vector<int>&, const string&);
     
     bool saveCompressedImage();
     void displayMetrics() const;
@@ -81,6 +226,102 @@ public:
     size_t getCompressedSize() const;
     
 private:
+    /**
+     * @brief Membuat QuadTree dengan seluruh pengaturan processor
+     * @param Threshold error yang dipakai
+     * @return QuadTree yang siap dibangun
+     */
+    unique_ptr<QuadTree> createQuadTree(double) const;
+
+    /**
+     * @brief Membuat PlanarQuadTree dengan seluruh pengaturan processor
+     * @param Threshold error yang dipakai
+     * @return PlanarQuadTree yang siap dibangun
+     */
+    unique_ptr<PlanarQuadTree> createPlanarQuadTree(double) const;
+
+    /**
+     * @brief Apakah format output ditulis langsung dari tree (.qtc, .qtp, .qti, .svg, .svgz)
+     * @param Path output
+     */
+    bool isTreeOutput(const string&) const;
+
+    /**
+     * @brief Apakah output dirender dan ditulis per band (--band-height atau .ppm)
+     * @param Path output
+     */
+    bool isBandOutput(const string&) const;
+
+    /**
+     * @brief Merender per band dan mengalirkan setiap band ke BandWriter
+     * @param Path output
+     * @param Jumlah thread encoder
+     * @param Fungsi yang merender baris [awal, akhir) ke buffer RGB band
+     * @return true jika berhasil
+     */
+    bool saveBands(const string&, int, const function<void(unsigned char*, int, int)>&) const;
+
+    /**
+     * @brief Menyimpan sebuah QuadTree ke path dengan format sesuai ekstensi
+     * @param QuadTree yang sudah dibangun
+     * @param Path output
+     * @param Jumlah thread encoder
+     * @param Raster RGB interleaved tree yang sudah ada (nullptr = dirasterisasi di sini)
+     * @return true jika berhasil
+     */
+    bool saveTree(const QuadTree&, const string&, int, const unsigned char* = nullptr) const;
+
+    /**
+     * @brief Mengukur ukuran file output sebuah tree tanpa menulis file (encode ke memori)
+     * @param QuadTree yang sudah dibangun
+     * @param Path output (menentukan format)
+     * @param Raster RGB interleaved tree
+     * @return Ukuran dalam byte, 0 jika encode gagal
+     */
+    size_t measureOutputSize(const QuadTree&, const string&, const unsigned char*) const;
+
+    /**
+     * @brief Menulis format tree (.qtc, .qtp, .qti, .svg, .svgz)
+     * @param QuadTree yang sudah dibangun
+     * @param Path output
+     * @return true jika berhasil
+     */
+    bool writeTreeFile(const QuadTree&, const string&) const;
+
+    /**
+     * @brief Menentukan sebelum rasterisasi apakah output ditulis sebagai PNG indexed
+     * @param Path output
+     * @param Tree yang akan dirasterisasi
+     * @param Output palet warna leaf
+     * @return true jika output PNG dan warna leaf muat di palet 256 warna
+     */
+    bool findOutputPalette(const string&, const QuadTree&, vector<RGB>&) const;
+
+    /**
+     * @brief Menulis gambar raster RGB (JPEG, BMP, QOI, atau PNG)
+     * @param Path output
+     * @param Buffer RGB interleaved
+     * @param Jumlah thread encoder PNG
+     * @return true jika berhasil
+     */
+    bool writeRaster(const string&, const unsigned char*, int) const;
+
+    /**
+     * @brief Menulis PNG indexed dari buffer indeks palet
+     * @param Path output
+     * @param Buffer indeks, satu byte per piksel
+     * @param Palet warna
+     * @param Jumlah thread encoder PNG
+     * @return true jika berhasil
+     */
+    bool writeIndexedRaster(const string&, const unsigned char*, const vector<RGB>&, int) const;
+
+    /**
+     * @brief Memuat peta kepentingan dari mask dan/atau region ROI
+     * @return true jika berhasil atau ROI tidak digunakan
+     */
+    bool loadImportanceMap();
+
     /**
      * @brief Mencari threshold yang sesuai untuk target persentase kompresi (Bonus)
      * @return Threshold yang sesuai
@@ -88,17 +329,11 @@ private:
     double findThresholdForTargetCompression();
     
     /**
-     * @brief Membuat GIF visualisasi proses kompresi (Bonus)
+     * @brief Membuat animasi visualisasi proses kompresi (Bonus): GIF dan/atau stream frame mentah
      * @return true jika berhasil, false jika gagal
      */
-    bool generateCompressionGif();
-    
-    /**
-     * @brief Menghitung ukuran file gambar
-     * @param Gambar yang dihitung ukurannya
-     * @return Ukuran gambar dalam bytes
-     */
-    size_t calculateImageSize(const vector<vector<RGB>>&) const;
+    bool generateCompressionAnimation();
+
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "ImageStatistics.hpp"
+#include <algorithm>
+
+namespace {
+    // Mengambil nilai channel tertentu dari sebuah piksel
+    inline unsigned char channelValue(const RGB& pixel, int channel) {
+        if (channel == 0) return pixel.getRed();
+        if (channel == 1) return pixel.getGreen();
+        return pixel.getBlue();
+    }
+}
+
+// Constructor
+ImageStatistics::ImageStatistics(shared_ptr<const vector<vector<RGB>>> _image, bool grayscale)
+    : image(_image), width(_image->empty() ? 0 : (*_image)[0].size()), height(_image->size()),
+      channelCount(grayscale ? 1 : 3) {
+}
+
+const vector<vector<RGB>>& ImageStatistics::getImage() const {
+    return *image;
+}
+
+int ImageStatistics::getWidth() const {
+    return width;
+}
+
+int ImageStatistics::getHeight() const {
+    return height;
+}
+
+long long ImageStatistics::getPixelCount(const Block& region) const {
+    int x0 = std::max(0, region.getX());
+    int y0 = std::max(0, region.getY());
+    int x1 = std::min(width, region.getX() + region.getWidth());
+    int y1 = std::min(height, region.getY() + region.getHeight());
+
+    if (x0 >= x1 || y0 >= y1) {
+        return 0;
+    }
+    return static_cast<long long>(x1 - x0) * (y1 - y0);
+}
+
+long long ImageStatistics::getChannelSum(const Block& region, int channel) const {
+    std::call_once(sumsBuilt, [this]() { buildSumTables(); });
+    return channelSum[tableIndex(channel)].getSum(region);
+}
+
+long long ImageStatistics::getChannelSquaredSum(const Block& region, int channel) const {
+    std::call_once(squaredSumsBuilt, [this]() { buildSquaredSumTables(); });
+    return channelSquaredSum[tableIndex(channel)].getSum(region);
+}
+
+// Menghitung warna rata-rata region
+RGB ImageStatistics::getAverageColor(const Block& region) const {
+    long long count = getPixelCount(region);
+    if (count == 0) {
+        return RGB(0, 0, 0);
+    }
+
+    return RGB(static_cast<unsigned char>(getChannelSum(region, 0) / count),
+               static_cast<unsigned char>(getChannelSum(region, 1) / count),
+               static_cast<unsigned char>(getChannelSum(region, 2) / count));
+}
+
+// sum((p - v)^2) = sum(p^2) - 2v*sum(p) + n*v^2
+long long ImageStatistics::getChannelSquaredError(const Block& region, int channel, unsigned char value) const {
+    long long v = value;
+    return getChannelSquaredSum(region, channel)
+         - 2 * v * getChannelSum(region, channel)
+         + getPixelCount(region) * v * v;
+}
+
+// sum((p - mean)^2) = sum(p^2) - sum(p)^2 / n
+double ImageStatistics::getSquaredDeviation(const Block& region) const {
+    long long count = getPixelCount(region);
+    if (count == 0) {
+        return 0.0;
+    }
+    double deviation = 0.0;
+    for (int c = 0; c < 3; c++) {
+        double sum = static_cast<double>(getChannelSum(region, c));
+        deviation += static_cast<double>(getChannelSquaredSum(region, c)) - sum * sum / count;
+    }
+    return deviation;
+}
+
+void ImageStatistics::getChannelMoments(const Block& region, int channel,
+                                        long long& sumX, long long& sumY, long long& sumXY) const {
+    std::call_once(momentsBuilt, [this]() { buildMomentTables(); });
+    int table = tableIndex(channel);
+    sumX = channelMomentX[table].getSum(region);
+    sumY = channelMomentY[table].getSum(region);
+    sumXY = channelMomentXY[table].getSum(region);
+}
+
+int ImageStatistics::tableIndex(int channel) const {
+    return channelCount == 1 ? 0 : channel;
+}
+
+// Jumlah nilai dipakai setiap tree (warna rata-rata node)
+void ImageStatistics::buildSumTables() const {
+    const vector<vector<RGB>>& pixels = *image;
+    for (int c = 0; c < channelCount; c++) {
+        channelSum[c] = IntegralImage(width, height, 255, [&pixels, c](int x, int y) {
+            return static_cast<long long>(channelValue(pixels[y][x], c));
+        });
+    }
+}
+
+// Jumlah kuadrat hanya dibutuhkan oleh variance, SSIM, partisi adaptif, dan leaf model
+void ImageStatistics::buildSquaredSumTables() const {
+    const vector<vector<RGB>>& pixels = *image;
+    for (int c = 0; c < channelCount; c++) {
+        channelSquaredSum[c] = IntegralImage(width, height, 255 * 255, [&pixels, c](int x, int y) {
+            long long value = channelValue(pixels[y][x], c);
+            return value * value;
+        });
+    }
+}
+
+// Tabel momen hanya dibutuhkan oleh leaf model non-flat
+void ImageStatistics::buildMomentTables() const {
+    const vector<vector<RGB>>& pixels = *image;
+    long long maxX = std::max(0, width - 1), maxY = std::max(0, height - 1);
+    for (int c = 0; c < channelCount; c++) {
+        channelMomentX[c] = IntegralImage(width, height, maxX * 255, [&pixels, c](int x, int y) {
+            return static_cast<long long>(x) * channelValue(pixels[y][x], c);
+        });
+        channelMomentY[c] = IntegralImage(width, height, maxY * 255, [&pixels, c](int x, int y) {
+            return static_cast<long long>(y) * channelValue(pixels[y][x], c);
+        });
+        channelMomentXY[c] = IntegralImage(width, height, maxX * maxY * 255, [&pixels, c](int x, int y) {
+            return static_cast<long long>(x) * y * channelValue(pixels[y][x], c);
+        });
+    }
+}
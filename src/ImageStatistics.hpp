@@ -0,0 +1,123 @@
+#ifndef __IMAGE_STATISTICS__HPP__
+#define __IMAGE_STATISTICS__HPP__
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "IntegralImage.hpp"
+#include "RGB.hpp"
+#include "Block.hpp"
+
+using namespace std;
+
+/**
+ * @class ImageStatistics
+ * @brief Statistik gambar yang dihitung sekali (summed-area table per channel)
+ *        dan dapat dipakai bersama oleh beberapa QuadTree sekaligus. Gambar tidak disalin,
+ *        dan setiap kelompok tabel baru dibangun saat pertama kali di-query (thread-safe)
+ */
+class ImageStatistics {
+private:
+    shared_ptr<const vector<vector<RGB>>> image; // Gambar original (dipakai bersama pemiliknya)
+    int width, height;
+    int channelCount;   // 1 untuk gambar grayscale (R=G=B): hanya tabel channel 0 yang dibangun
+
+    mutable once_flag sumsBuilt;
+    mutable IntegralImage channelSum[3];    // Jumlah nilai per channel (0=R, 1=G, 2=B)
+    mutable once_flag squaredSumsBuilt;
+    mutable IntegralImage channelSquaredSum[3]; // Jumlah kuadrat nilai per channel
+    
+    // Tabel momen pertama (x*p, y*p, x*y*p), dibangun saat pertama kali dibutuhkan
+    mutable once_flag momentsBuilt;
+    mutable IntegralImage channelMomentX[3];
+    mutable IntegralImage channelMomentY[3];
+    mutable IntegralImage channelMomentXY[3];
+
+public:
+    /**
+     * @brief Constructor; tabel statistik dibangun saat pertama kali dibutuhkan
+     * @param Gambar yang dianalisis
+     * @param true jika R=G=B di setiap piksel, sehingga satu set tabel dipakai untuk ketiga channel
+     */
+    ImageStatistics(shared_ptr<const vector<vector<RGB>>>, bool = false);
+
+    const vector<vector<RGB>>& getImage() const;
+    int getWidth() const;
+    int getHeight() const;
+
+    /**
+     * @brief Menghitung jumlah piksel region yang berada di dalam gambar
+     * @param Region yang dihitung
+     * @return Jumlah piksel
+     */
+    long long getPixelCount(const Block&) const;
+
+    /**
+     * @brief Menghitung jumlah nilai satu channel dalam region
+     * @param Region yang dihitung
+     * @param Offset channel (0=R, 1=G, 2=B)
+     * @return Jumlah nilai channel
+     */
+    long long getChannelSum(const Block&, int) const;
+
+    /**
+     * @brief Menghitung jumlah kuadrat nilai satu channel dalam region
+     * @param Region yang dihitung
+     * @param Offset channel (0=R, 1=G, 2=B)
+     * @return Jumlah kuadrat nilai channel
+     */
+    long long getChannelSquaredSum(const Block&, int) const;
+
+    /**
+     * @brief Menghitung warna rata-rata region dalam O(1)
+     * @param Region yang dihitung
+     * @return Warna rata-rata (dibulatkan ke bawah seperti perhitungan langsung)
+     */
+    RGB getAverageColor(const Block&) const;
+
+    /**
+     * @brief Menghitung jumlah kuadrat selisih satu channel terhadap sebuah nilai dalam O(1)
+     * @param Region yang dihitung
+     * @param Offset channel (0=R, 1=G, 2=B)
+     * @param Nilai pembanding
+     * @return Jumlah (piksel - nilai)^2
+     */
+    long long getChannelSquaredError(const Block&, int, unsigned char) const;
+
+    /**
+     * @brief Menghitung jumlah kuadrat deviasi terhadap rata-rata (ketiga channel) dalam O(1)
+     * @param Region yang dihitung
+     * @return Sum of squared deviation R + G + B
+     */
+    double getSquaredDeviation(const Block&) const;
+
+    /**
+     * @brief Menghitung momen pertama satu channel dalam region (thread-safe)
+     * @param Region yang dihitung
+     * @param Offset channel (0=R, 1=G, 2=B)
+     * @param Output jumlah x*p
+     * @param Output jumlah y*p
+     * @param Output jumlah x*y*p
+     */
+    void getChannelMoments(const Block&, int, long long&, long long&, long long&) const;
+
+private:
+    int tableIndex(int) const;
+
+    /**
+     * @brief Membangun tabel jumlah nilai untuk semua channel
+     */
+    void buildSumTables() const;
+
+    /**
+     * @brief Membangun tabel jumlah kuadrat untuk semua channel
+     */
+    void buildSquaredSumTables() const;
+
+    /**
+     * @brief Membangun tabel momen pertama untuk semua channel
+     */
+    void buildMomentTables() const;
+};
+
+#endif
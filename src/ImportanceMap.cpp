@@ -0,0 +1,36 @@
+#include "ImportanceMap.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Constructor
+ImportanceMap::ImportanceMap(int _width, int _height, const unsigned char* mask,
+                             int maskWidth, int maskHeight,
+                             const vector<Block>& regions, double strength)
+    : width(_width), height(_height),
+      fineScale(1.0 / std::max(1.0, strength)), coarseScale(std::max(1.0, strength)) {
+    importance = IntegralImage(width, height, 255, [&](int x, int y) -> long long {
+        for (const Block& region : regions) {
+            if (region.contains(x, y)) {
+                return 255;
+            }
+        }
+        if (!mask || maskWidth <= 0 || maskHeight <= 0) {
+            return 0;
+        }
+        // Mask dengan ukuran berbeda diskalakan nearest-neighbor
+        int mx = static_cast<int>(static_cast<long long>(x) * maskWidth / width);
+        int my = static_cast<int>(static_cast<long long>(y) * maskHeight / height);
+        return mask[static_cast<size_t>(my) * maskWidth + mx];
+    });
+}
+
+// Skala diinterpolasi geometris: coarse * (fine/coarse)^m, m = kepentingan rata-rata 0..1
+double ImportanceMap::getThresholdScale(const Block& region) const {
+    long long area = static_cast<long long>(region.getWidth()) * region.getHeight();
+    if (area <= 0) {
+        return 1.0;
+    }
+
+    double meanImportance = static_cast<double>(importance.getSum(region)) / (area * 255.0);
+    return coarseScale * std::pow(fineScale / coarseScale, meanImportance);
+}
@@ -0,0 +1,43 @@
+#ifndef __IMPORTANCE_MAP__HPP__
+#define __IMPORTANCE_MAP__HPP__
+
+#include <vector>
+#include "IntegralImage.hpp"
+#include "Block.hpp"
+
+using namespace std;
+
+/**
+ * @class ImportanceMap
+ * @brief Peta kepentingan region (region of interest) untuk menskalakan threshold per blok.
+ *        Nilai 255 berarti penting (blok halus), 0 berarti latar (blok kasar)
+ */
+class ImportanceMap {
+private:
+    int width, height;
+    IntegralImage importance;   // Summed-area table nilai kepentingan 0-255
+    double fineScale;           // Skala threshold untuk kepentingan penuh
+    double coarseScale;         // Skala threshold untuk kepentingan nol
+
+public:
+    /**
+     * @brief Constructor dari mask grayscale dan/atau daftar region penting
+     * @param Lebar gambar
+     * @param Tinggi gambar
+     * @param Data mask grayscale 1 channel (boleh nullptr), diskalakan ke ukuran gambar
+     * @param Lebar mask
+     * @param Tinggi mask
+     * @param Daftar region yang dianggap penting penuh
+     * @param Skala kekuatan (threshold dikali 1/k pada region penting dan k pada latar)
+     */
+    ImportanceMap(int, int, const unsigned char*, int, int, const vector<Block>&, double = 4.0);
+
+    /**
+     * @brief Menghitung skala threshold untuk sebuah blok dalam O(1)
+     * @param Region blok
+     * @return Faktor pengali threshold (1.0 untuk kepentingan 50%)
+     */
+    double getThresholdScale(const Block&) const;
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "IntegralImage.hpp"
+#include <algorithm>
+
+
+IntegralImage::IntegralImage() : width(0), height(0) {}
+
+// Membangun summed-area table baris per baris
+IntegralImage::IntegralImage(int _width, int _height, long long maxValue, const function<long long(int, int)>& value)
+    : width(_width), height(_height) {
+    size_t stride = static_cast<size_t>(width) + 1;
+    size_t cells = stride * (static_cast<size_t>(height) + 1);
+    double maxTotal = static_cast<double>(maxValue) * width * height;
+
+    if (maxTotal < 4294967296.0) {
+        lowTable.assign(cells, 0);
+        for (int y = 0; y < height; y++) {
+            uint32_t rowSum = 0;
+            const uint32_t* above = &lowTable[static_cast<size_t>(y) * stride];
+            uint32_t* current = &lowTable[static_cast<size_t>(y + 1) * stride];
+            for (int x = 0; x < width; x++) {
+                rowSum += static_cast<uint32_t>(value(x, y));
+                current[x + 1] = above[x + 1] + rowSum;
+            }
+        }
+        return;
+    }
+
+    if (maxTotal < 281474976710656.0) {
+        lowTable.assign(cells, 0);
+        highTable.assign(cells, 0);
+        for (int y = 0; y < height; y++) {
+            long long rowSum = 0;
+            size_t above = static_cast<size_t>(y) * stride;
+            size_t current = above + stride;
+            for (int x = 0; x < width; x++) {
+                rowSum += value(x, y);
+                long long total = entry(above + x + 1) + rowSum;
+                lowTable[current + x + 1] = static_cast<uint32_t>(total);
+                highTable[current + x + 1] = static_cast<uint16_t>(total >> 32);
+            }
+        }
+        return;
+    }
+
+    wideTable.assign(cells, 0);
+    for (int y = 0; y < height; y++) {
+        long long rowSum = 0;
+        const long long* above = &wideTable[static_cast<size_t>(y) * stride];
+        long long* current = &wideTable[static_cast<size_t>(y + 1) * stride];
+        for (int x = 0; x < width; x++) {
+            rowSum += value(x, y);
+            current[x + 1] = above[x + 1] + rowSum;
+        }
+    }
+}
+
+long long IntegralImage::entry(size_t index) const {
+    if (!wideTable.empty()) {
+        return wideTable[index];
+    }
+    long long high = highTable.empty() ? 0 : static_cast<long long>(highTable[index]) << 32;
+    return high | lowTable[index];
+}
+
+int IntegralImage::getWidth() const {
+    return width;
+}
+
+int IntegralImage::getHeight() const {
+    return height;
+}
+
+long long IntegralImage::getSum(const Block& region) const {
+    int x0 = std::max(0, region.getX());
+    int y0 = std::max(0, region.getY());
+    int x1 = std::min(width, region.getX() + region.getWidth());
+    int y1 = std::min(height, region.getY() + region.getHeight());
+
+    if (x0 >= x1 || y0 >= y1) {
+        return 0;
+    }
+
+    size_t stride = static_cast<size_t>(width) + 1;
+    if (highTable.empty() && wideTable.empty()) {
+        // Aritmetika unsigned modulo 2^32: hasilnya tepat karena jumlah region < 2^32
+        uint32_t sum = lowTable[y1 * stride + x1] - lowTable[y0 * stride + x1]
+                     - lowTable[y1 * stride + x0] + lowTable[y0 * stride + x0];
+        return sum;
+    }
+    return entry(y1 * stride + x1) - entry(y0 * stride + x1)
+         - entry(y1 * stride + x0) + entry(y0 * stride + x0);
+}
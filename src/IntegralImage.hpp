@@ -0,0 +1,49 @@
+#ifndef __INTEGRAL_IMAGE__HPP__
+#define __INTEGRAL_IMAGE__HPP__
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+#include "Block.hpp"
+
+using namespace std;
+
+/**
+ * @class IntegralImage
+ * @brief Summed-area table untuk satu bidang nilai, query jumlah region dalam O(1).
+ *        Lebar entri dipilih dari batas atas jumlah seluruh bidang: 32-bit (selisih modulo 2^32
+ *        tetap tepat untuk setiap region), 48-bit (32-bit bawah + 16-bit atas), atau 64-bit
+ */
+class IntegralImage {
+private:
+    int width, height;
+    vector<uint32_t> lowTable;      // (width+1) x (height+1), baris/kolom 0 bernilai 0; 32-bit bawah
+    vector<uint16_t> highTable;     // 16-bit atas, hanya jika jumlah total bisa >= 2^32
+    vector<long long> wideTable;    // Dipakai alih-alih dua tabel di atas jika jumlah total bisa >= 2^48
+
+    long long entry(size_t) const;
+
+public:
+    IntegralImage();
+
+    /**
+     * @brief Constructor yang membangun tabel dari fungsi nilai per piksel
+     * @param Lebar bidang
+     * @param Tinggi bidang
+     * @param Nilai maksimum satu piksel (menentukan lebar tabel)
+     * @param Fungsi nilai piksel (x, y), tidak negatif
+     */
+    IntegralImage(int, int, long long, const function<long long(int, int)>&);
+
+    int getWidth() const;
+    int getHeight() const;
+
+    /**
+     * @brief Menghitung jumlah nilai di dalam region (dipotong ke batas bidang)
+     * @param Region yang dijumlahkan
+     * @return Jumlah nilai piksel dalam region
+     */
+    long long getSum(const Block&) const;
+};
+
+#endif
@@ -0,0 +1,229 @@
+#include "LeafModel.hpp"
+#include <algorithm>
+#include <cmath>
+
+LeafModel::~LeafModel() {}
+
+const Block& LeafModel::getRegion() const {
+    return region;
+}
+
+const RGB& LeafModel::getCorner(int index) const {
+    return corners[index];
+}
+
+double LeafModel::getMean(int channel) const {
+    return mean[channel];
+}
+
+double LeafModel::getVariance(int channel) const {
+    return variance[channel];
+}
+
+double LeafModel::getSquaredError(int channel) const {
+    return squaredError[channel];
+}
+
+void LeafModel::setCorners(const Block& block, const RGB values[]) {
+    region = block;
+    for (int c = 0; c < 3; c++) {
+        mean[c] = variance[c] = squaredError[c] = 0.0;
+    }
+    for (int i = 0; i < getCornerCount(); i++) {
+        corners[i] = values[i];
+    }
+}
+
+unique_ptr<LeafModel> LeafModel::create(Type type) {
+    switch (type) {
+        case PLANAR:
+            return make_unique<PlanarModel>();
+        case BILINEAR:
+            return make_unique<BilinearModel>();
+        default:
+            return nullptr;
+    }
+}
+
+int LeafModel::getParameterBytes(Type type) {
+    switch (type) {
+        case PLANAR:
+            return 3 * 3;
+        case BILINEAR:
+            return 4 * 3;
+        default:
+            return 3;
+    }
+}
+
+unsigned char LeafModel::toByte(double value) {
+    return static_cast<unsigned char>(std::max(0.0, std::min(255.0, std::round(value))));
+}
+
+// Basis u = x - cx, v = y - cy, dan u*v saling ortogonal pada grid persegi panjang,
+// sehingga setiap koefisien dapat dihitung terpisah dari momen pertama region
+double LeafModel::fitChannel(const ImageStatistics& statistics, const Block& block, int channel,
+                             bool crossTerm, double coefficients[4], double& pixelVariance) {
+    double n = static_cast<double>(statistics.getPixelCount(block));
+    coefficients[0] = coefficients[1] = coefficients[2] = coefficients[3] = 0.0;
+    pixelVariance = 0.0;
+    if (n == 0) {
+        return 0.0;
+    }
+
+    long long momentX, momentY, momentXY;
+    statistics.getChannelMoments(block, channel, momentX, momentY, momentXY);
+    double sum = static_cast<double>(statistics.getChannelSum(block, channel));
+    double squaredSum = static_cast<double>(statistics.getChannelSquaredSum(block, channel));
+
+    double w = block.getWidth(), h = block.getHeight();
+    double cx = block.getX() + (w - 1) / 2.0;
+    double cy = block.getY() + (h - 1) / 2.0;
+
+    // Korelasi piksel dengan basis terpusat
+    double sumU = momentX - cx * sum;
+    double sumV = momentY - cy * sum;
+    double sumUV = momentXY - cy * momentX - cx * momentY + cx * cy * sum;
+
+    // Jumlah kuadrat basis: sum(u^2) = h * w(w^2-1)/12, sum(v^2) = w * h(h^2-1)/12
+    double rowSpread = w * (w * w - 1) / 12.0;
+    double colSpread = h * (h * h - 1) / 12.0;
+    double normU = h * rowSpread;
+    double normV = w * colSpread;
+    double normUV = rowSpread * colSpread;
+
+    double sse = std::max(0.0, squaredSum - sum * sum / n);
+    pixelVariance = sse / n;
+    coefficients[0] = sum / n;
+    if (normU > 0) {
+        coefficients[1] = sumU / normU;
+        sse -= sumU * coefficients[1];
+    }
+    if (normV > 0) {
+        coefficients[2] = sumV / normV;
+        sse -= sumV * coefficients[2];
+    }
+    if (crossTerm && normUV > 0) {
+        coefficients[3] = sumUV / normUV;
+        sse -= sumUV * coefficients[3];
+    }
+    return std::max(0.0, sse);
+}
+
+double LeafModel::coefficientError(const Block& block, bool crossTerm, const double fitted[4],
+                                   const double rendered[4]) {
+    double w = block.getWidth(), h = block.getHeight();
+    double rowSpread = w * (w * w - 1) / 12.0;
+    double colSpread = h * (h * h - 1) / 12.0;
+    double norms[4] = { w * h, h * rowSpread, w * colSpread, crossTerm ? rowSpread * colSpread : 0.0 };
+
+    double error = 0.0;
+    for (int i = 0; i < 4; i++) {
+        double delta = rendered[i] - fitted[i];
+        error += norms[i] * delta * delta;
+    }
+    return error;
+}
+
+// ==================== PlanarModel ====================
+
+LeafModel::Type PlanarModel::getType() const {
+    return PLANAR;
+}
+
+int PlanarModel::getCornerCount() const {
+    return 3;
+}
+
+// Bidang disimpan sebagai warna pada pojok kiri-atas, kanan-atas, dan kiri-bawah
+void PlanarModel::fit(const ImageStatistics& statistics, const Block& block) {
+    region = block;
+    double halfW = (block.getWidth() - 1) / 2.0;
+    double halfH = (block.getHeight() - 1) / 2.0;
+    unsigned char values[3][3];
+
+    for (int c = 0; c < 3; c++) {
+        double k[4];
+        double fitError = fitChannel(statistics, block, c, false, k, variance[c]);
+        mean[c] = k[0];
+        values[0][c] = toByte(k[0] - k[1] * halfW - k[2] * halfH);
+        values[1][c] = toByte(k[0] + k[1] * halfW - k[2] * halfH);
+        values[2][c] = toByte(k[0] - k[1] * halfW + k[2] * halfH);
+
+        // Error dihitung terhadap bidang yang benar-benar dirender predict(); pemotongan per piksel
+        // di predict() hanya mendekatkan prediksi ke rentang piksel, jadi nilai ini batas atas
+        double rendered[4] = { 0.0, 0.0, 0.0, 0.0 };
+        rendered[1] = halfW > 0 ? (values[1][c] - values[0][c]) / (2 * halfW) : 0.0;
+        rendered[2] = halfH > 0 ? (values[2][c] - values[0][c]) / (2 * halfH) : 0.0;
+        rendered[0] = values[0][c] + rendered[1] * halfW + rendered[2] * halfH;
+        squaredError[c] = fitError + coefficientError(block, false, k, rendered);
+    }
+    for (int i = 0; i < 3; i++) {
+        corners[i] = RGB(values[i][0], values[i][1], values[i][2]);
+    }
+}
+
+RGB PlanarModel::predict(int x, int y) const {
+    double fx = region.getWidth() > 1 ? static_cast<double>(x - region.getX()) / (region.getWidth() - 1) : 0.0;
+    double fy = region.getHeight() > 1 ? static_cast<double>(y - region.getY()) / (region.getHeight() - 1) : 0.0;
+    const RGB& tl = corners[0];
+    const RGB& tr = corners[1];
+    const RGB& bl = corners[2];
+
+    return RGB(toByte(tl.getRed() + (tr.getRed() - tl.getRed()) * fx + (bl.getRed() - tl.getRed()) * fy),
+               toByte(tl.getGreen() + (tr.getGreen() - tl.getGreen()) * fx + (bl.getGreen() - tl.getGreen()) * fy),
+               toByte(tl.getBlue() + (tr.getBlue() - tl.getBlue()) * fx + (bl.getBlue() - tl.getBlue()) * fy));
+}
+
+// ==================== BilinearModel ====================
+
+LeafModel::Type BilinearModel::getType() const {
+    return BILINEAR;
+}
+
+int BilinearModel::getCornerCount() const {
+    return 4;
+}
+
+void BilinearModel::fit(const ImageStatistics& statistics, const Block& block) {
+    region = block;
+    double halfW = (block.getWidth() - 1) / 2.0;
+    double halfH = (block.getHeight() - 1) / 2.0;
+    unsigned char values[4][3];
+
+    for (int c = 0; c < 3; c++) {
+        double k[4];
+        double fitError = fitChannel(statistics, block, c, true, k, variance[c]);
+        mean[c] = k[0];
+        values[0][c] = toByte(k[0] - k[1] * halfW - k[2] * halfH + k[3] * halfW * halfH);
+        values[1][c] = toByte(k[0] + k[1] * halfW - k[2] * halfH - k[3] * halfW * halfH);
+        values[2][c] = toByte(k[0] - k[1] * halfW + k[2] * halfH - k[3] * halfW * halfH);
+        values[3][c] = toByte(k[0] + k[1] * halfW + k[2] * halfH + k[3] * halfW * halfH);
+
+        // Koefisien permukaan bilinear yang dirender predict() dari keempat pojok tersimpan
+        double v0 = values[0][c], v1 = values[1][c], v2 = values[2][c], v3 = values[3][c];
+        double rendered[4];
+        rendered[0] = (v0 + v1 + v2 + v3) / 4.0;
+        rendered[1] = halfW > 0 ? (v1 + v3 - v0 - v2) / (4 * halfW) : 0.0;
+        rendered[2] = halfH > 0 ? (v2 + v3 - v0 - v1) / (4 * halfH) : 0.0;
+        rendered[3] = halfW > 0 && halfH > 0 ? (v0 + v3 - v1 - v2) / (4 * halfW * halfH) : 0.0;
+        squaredError[c] = fitError + coefficientError(block, true, k, rendered);
+    }
+    for (int i = 0; i < 4; i++) {
+        corners[i] = RGB(values[i][0], values[i][1], values[i][2]);
+    }
+}
+
+RGB BilinearModel::predict(int x, int y) const {
+    double fx = region.getWidth() > 1 ? static_cast<double>(x - region.getX()) / (region.getWidth() - 1) : 0.0;
+    double fy = region.getHeight() > 1 ? static_cast<double>(y - region.getY()) / (region.getHeight() - 1) : 0.0;
+    double weights[4] = { (1 - fx) * (1 - fy), fx * (1 - fy), (1 - fx) * fy, fx * fy };
+
+    double r = 0, g = 0, b = 0;
+    for (int i = 0; i < 4; i++) {
+        r += weights[i] * corners[i].getRed();
+        g += weights[i] * corners[i].getGreen();
+        b += weights[i] * corners[i].getBlue();
+    }
+    return RGB(toByte(r), toByte(g), toByte(b));
+}
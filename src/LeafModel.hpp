@@ -0,0 +1,143 @@
+#ifndef __LEAF_MODEL__HPP__
+#define __LEAF_MODEL__HPP__
+
+#include <memory>
+#include "Block.hpp"
+#include "RGB.hpp"
+#include "ImageStatistics.hpp"
+
+using namespace std;
+
+/**
+ * @class LeafModel
+ * @brief Interface prediktor warna untuk leaf node. Model FLAT adalah warna rata-rata
+ *        Node::avgColor (tanpa objek model); model lain di-fit dengan least squares
+ *        menggunakan tabel momen ImageStatistics dalam O(1) per blok
+ */
+class LeafModel {
+public:
+
+    enum Type {
+        FLAT,       // Warna rata-rata (bawaan)
+        PLANAR,     // a + bx + cy per channel, disimpan sebagai 3 warna pojok
+        BILINEAR    // Interpolasi bilinear dari 4 warna pojok
+    };
+
+protected:
+    Block region;
+    double mean[3];             // Rata-rata per channel
+    double variance[3];         // Variance piksel per channel
+    double squaredError[3];     // Jumlah kuadrat residual per channel terhadap model dari warna pojok tersimpan
+    RGB corners[4];             // Warna pojok: kiri-atas, kanan-atas, kiri-bawah, kanan-bawah
+
+public:
+    virtual ~LeafModel();
+
+    virtual Type getType() const = 0;
+
+    /**
+     * @brief Melakukan fitting model pada region
+     * @param Statistik gambar (dengan tabel momen)
+     * @param Region yang di-fit
+     */
+    virtual void fit(const ImageStatistics&, const Block&) = 0;
+
+    /**
+     * @brief Memulihkan model dari warna pojok (misalnya hasil dekode file)
+     * @param Region model
+     * @param Warna pojok sebanyak getCornerCount()
+     */
+    void setCorners(const Block&, const RGB[]);
+
+    /**
+     * @brief Memprediksi warna piksel di dalam region
+     * @param Koordinat x piksel
+     * @param Koordinat y piksel
+     * @return Warna hasil prediksi
+     */
+    virtual RGB predict(int, int) const = 0;
+
+    /**
+     * @brief Jumlah warna pojok yang menjadi parameter model
+     */
+    virtual int getCornerCount() const = 0;
+
+    const Block& getRegion() const;
+    const RGB& getCorner(int) const;
+    double getMean(int) const;
+    double getVariance(int) const;
+
+    /**
+     * @brief Jumlah kuadrat residual model yang dirender (warna pojok tersimpan) untuk satu channel
+     * @param Offset channel (0=R, 1=G, 2=B)
+     * @return Sum of squared error
+     */
+    double getSquaredError(int) const;
+
+    /**
+     * @brief Membuat model sesuai tipe
+     * @param Tipe model (FLAT mengembalikan nullptr)
+     * @return Model baru
+     */
+    static unique_ptr<LeafModel> create(Type);
+
+    /**
+     * @brief Jumlah byte parameter warna per leaf untuk tipe model
+     * @param Tipe model
+     * @return Byte parameter (3 untuk FLAT)
+     */
+    static int getParameterBytes(Type);
+
+protected:
+    /**
+     * @brief Fitting least squares a + b*u + c*v (+ d*u*v) dengan koordinat terpusat
+     * @param Statistik gambar
+     * @param Region
+     * @param Offset channel
+     * @param Sertakan suku silang u*v
+     * @param Output koefisien {a, b, c, d}
+     * @param Output variance piksel
+     * @return Sum of squared error
+     */
+    static double fitChannel(const ImageStatistics&, const Block&, int, bool, double[4], double&);
+
+    /**
+     * @brief Tambahan sum of squared error karena koefisien yang dirender (dari warna pojok yang
+     *        dibulatkan dan dipotong ke 0-255) berbeda dari koefisien least squares. Residual least
+     *        squares ortogonal terhadap basis, jadi tambahannya sum(basis^2) * selisih^2 per suku
+     * @param Region
+     * @param Sertakan suku silang u*v
+     * @param Koefisien least squares {a, b, c, d}
+     * @param Koefisien model yang dirender {a, b, c, d}
+     * @return Tambahan sum of squared error
+     */
+    static double coefficientError(const Block&, bool, const double[4], const double[4]);
+
+    static unsigned char toByte(double);
+};
+
+/**
+ * @class PlanarModel
+ * @brief Model bidang miring a + bx + cy per channel
+ */
+class PlanarModel : public LeafModel {
+public:
+    Type getType() const override;
+    void fit(const ImageStatistics&, const Block&) override;
+    RGB predict(int, int) const override;
+    int getCornerCount() const override;
+};
+
+/**
+ * @class BilinearModel
+ * @brief Model interpolasi bilinear dari empat warna pojok
+ */
+class BilinearModel : public LeafModel {
+public:
+    Type getType() const override;
+    void fit(const ImageStatistics&, const Block&) override;
+    RGB predict(int, int) const override;
+    int getCornerCount() const override;
+};
+
+#endif
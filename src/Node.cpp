@@ -2,7 +2,8 @@
 
 
 Node::Node(const Block& _region, const RGB& _avgColor, bool _isLeaf)
-    : region(_region), avgColor(_avgColor), isLeaf(_isLeaf),
+    : region(_region), avgColor(_avgColor), isLeaf(_isLeaf), model(nullptr),
+      splitX(_region.getWidth() / 2), splitY(_region.getHeight() / 2),
       topLeft(nullptr), topRight(nullptr), bottomLeft(nullptr), bottomRight(nullptr) {}
 
 
@@ -20,6 +21,10 @@ bool Node::getIsLeaf() const {
     return isLeaf;
 }
 
+const LeafModel* Node::getModel() const {
+    return model.get();
+}
+
 // Mendapatkan child node pada kuadran tertentu
 Node* Node::getChild(int quadrant) const {
     switch (quadrant) {
@@ -34,4 +39,21 @@ Node* Node::getChild(int quadrant) const {
         default:
             return nullptr;
     }
-}
\ No newline at end of file
+}
+
+unique_ptr<Node>& Node::getChildSlot(int quadrant) {
+    switch (quadrant) {
+        case 0: return topLeft;
+        case 1: return topRight;
+        case 2: return bottomLeft;
+        default: return bottomRight;
+    }
+}
+
+int Node::getSplitX() const {
+    return splitX;
+}
+
+int Node::getSplitY() const {
+    return splitY;
+}
@@ -4,6 +4,7 @@
 #include <memory>
 #include "Block.hpp"
 #include "RGB.hpp"
+#include "LeafModel.hpp"
 
 using namespace std;
 class QuadTree;
@@ -17,6 +18,8 @@ class Node {
         Block region;    
         RGB avgColor;    
         bool isLeaf;     
+        unique_ptr<LeafModel> model;    // Prediktor warna leaf (nullptr = warna rata-rata)
+        int splitX, splitY;             // Offset garis potong dari pojok kiri atas region
         
         // Child nodes
         unique_ptr<Node> topLeft;
@@ -25,6 +28,12 @@ class Node {
         unique_ptr<Node> bottomRight;
         
         friend class QuadTree;
+
+        /**
+         * @brief Slot child node pada kuadran tertentu (untuk QuadTree)
+         * @param Nomor kuadran (0-3)
+         */
+        unique_ptr<Node>& getChildSlot(int);
         
     public:
         /**
@@ -39,6 +48,12 @@ class Node {
         const Block& getRegion() const;
         const RGB& getAvgColor() const;
         bool getIsLeaf() const;
+
+        /**
+         * @brief Mendapatkan leaf model node
+         * @return Pointer ke model, nullptr jika leaf memakai warna rata-rata
+         */
+        const LeafModel* getModel() const;
         
         /**
          * @brief Mendapatkan child node pada kuadran tertentu
@@ -46,6 +61,16 @@ class Node {
          * @return Pointer ke child node pada kuadran yang diminta
          */
         Node* getChild(int) const;
+
+        /**
+         * @brief Offset garis potong vertikal (sama dengan lebar jika tidak ada potongan vertikal)
+         */
+        int getSplitX() const;
+
+        /**
+         * @brief Offset garis potong horizontal (sama dengan tinggi jika tidak ada potongan horizontal)
+         */
+        int getSplitY() const;
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "PlanarQuadTree.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    inline unsigned char clampToByte(double value) {
+        return static_cast<unsigned char>(std::max(0.0, std::min(255.0, std::round(value))));
+    }
+
+    // Konversi RGB ke YCbCr full-range (BT.601, seperti JPEG)
+    inline unsigned char toYCbCr(const RGB& pixel, int channel) {
+        double r = pixel.getRed(), g = pixel.getGreen(), b = pixel.getBlue();
+        if (channel == 0) return clampToByte(0.299 * r + 0.587 * g + 0.114 * b);
+        if (channel == 1) return clampToByte(128.0 - 0.168736 * r - 0.331264 * g + 0.5 * b);
+        return clampToByte(128.0 + 0.5 * r - 0.418688 * g - 0.081312 * b);
+    }
+
+    inline RGB fromYCbCr(unsigned char yValue, unsigned char cbValue, unsigned char crValue) {
+        double y = yValue, cb = cbValue - 128.0, cr = crValue - 128.0;
+        return RGB(clampToByte(y + 1.402 * cr),
+                   clampToByte(y - 0.344136 * cb - 0.714136 * cr),
+                   clampToByte(y + 1.772 * cb));
+    }
+}
+
+// Constructor, setiap channel mendapat QuadTree dengan gambar grayscale sendiri; statistiknya
+// hanya menyimpan satu set tabel karena ketiga komponen plane bernilai sama
+PlanarQuadTree::PlanarQuadTree(const vector<vector<RGB>>& image, ChannelMode _mode,
+                               int minBlockSize, double threshold,
+                               QuadTree::ErrorMetricType errorMetric, int _threadCount)
+    : mode(_mode), width(image.empty() ? 0 : image[0].size()), height(image.size()),
+      threadCount(_threadCount) {
+    if (mode == JOINT) {
+        throw std::invalid_argument("PlanarQuadTree requires RGB_PLANES or YCBCR_PLANES mode");
+    }
+    for (int c = 0; c < 3; c++) {
+        auto plane = make_shared<const vector<vector<RGB>>>(extractPlane(image, c));
+        planes[c] = make_unique<QuadTree>(make_shared<ImageStatistics>(plane, true), minBlockSize, threshold,
+                                          errorMetric);
+    }
+}
+
+void PlanarQuadTree::setImportanceMap(shared_ptr<const ImportanceMap> map) {
+    for (int c = 0; c < 3; c++) {
+        planes[c]->setImportanceMap(map);
+    }
+}
+
+void PlanarQuadTree::setLeafModel(LeafModel::Type type) {
+    for (int c = 0; c < 3; c++) {
+        planes[c]->setLeafModel(type);
+    }
+}
+
+void PlanarQuadTree::setPartitionMode(QuadTree::PartitionMode mode) {
+    for (int c = 0; c < 3; c++) {
+        planes[c]->setPartitionMode(mode);
+    }
+}
+
+void PlanarQuadTree::setSplitGrid(int grid) {
+    for (int c = 0; c < 3; c++) {
+        planes[c]->setSplitGrid(grid);
+    }
+}
+
+// Ketiga tree independen sehingga dapat dibangun bersamaan
+void PlanarQuadTree::buildTree() {
+    int workers = threadCount > 0 ? threadCount : Utils::getDefaultThreadCount();
+    Utils::parallelFor(3, std::min(workers, 3), [this](int c) {
+        planes[c]->buildTree();
+    });
+}
+
+vector<vector<RGB>> PlanarQuadTree::getCompressedImage() const {
+    vector<vector<RGB>> planeImages[3];
+    for (int c = 0; c < 3; c++) {
+        planeImages[c] = planes[c]->getCompressedImage();
+    }
+
+    // Setiap gambar plane berisi nilai channel pada komponen merah
+    vector<vector<RGB>> result(height, vector<RGB>(width));
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            unsigned char v0 = planeImages[0][y][x].getRed();
+            unsigned char v1 = planeImages[1][y][x].getRed();
+            unsigned char v2 = planeImages[2][y][x].getRed();
+            result[y][x] = (mode == YCBCR_PLANES) ? fromYCbCr(v0, v1, v2) : RGB(v0, v1, v2);
+        }
+    }
+    return result;
+}
+
+// Setiap plane dirasterisasi ke buffer satu channel, lalu digabung per piksel
+void PlanarQuadTree::rasterize(unsigned char* buffer, int channels) const {
+    rasterizeRows(buffer, channels, 0, height);
+}
+
+void PlanarQuadTree::rasterizeRows(unsigned char* buffer, int channels, int firstRow, int lastRow) const {
+    firstRow = std::max(firstRow, 0);
+    lastRow = std::min(lastRow, height);
+    if (firstRow >= lastRow) {
+        return;
+    }
+    size_t pixelCount = static_cast<size_t>(width) * (lastRow - firstRow);
+    vector<unsigned char> planeValues[3];
+    for (int c = 0; c < 3; c++) {
+        planeValues[c].assign(pixelCount, 0);
+        planes[c]->rasterizeRows(planeValues[c].data(), 1, firstRow, lastRow);
+    }
+
+    unsigned char* pixel = buffer;
+    for (size_t i = 0; i < pixelCount; i++, pixel += channels) {
+        unsigned char v0 = planeValues[0][i], v1 = planeValues[1][i], v2 = planeValues[2][i];
+        if (mode == YCBCR_PLANES) {
+            RGB color = fromYCbCr(v0, v1, v2);
+            v0 = color.getRed();
+            v1 = color.getGreen();
+            v2 = color.getBlue();
+        }
+        pixel[0] = v0;
+        pixel[1] = v1;
+        pixel[2] = v2;
+        if (channels == 4) {
+            pixel[3] = 255;
+        }
+    }
+}
+
+int PlanarQuadTree::getNodeCount() const {
+    return planes[0]->getNodeCount() + planes[1]->getNodeCount() + planes[2]->getNodeCount();
+}
+
+int PlanarQuadTree::getMaxDepth() const {
+    return std::max({ planes[0]->getMaxDepth(), planes[1]->getMaxDepth(), planes[2]->getMaxDepth() });
+}
+
+size_t PlanarQuadTree::getEstimatedCompressedSize() const {
+    size_t size = 0;
+    for (int c = 0; c < 3; c++) {
+        const QuadTree& plane = *planes[c];
+        size_t leaves = plane.getLeafCount();
+        size_t internals = plane.getNodeCount() - leaves;
+        size += static_cast<size_t>(plane.getNodeCount()) * 16 + internals
+              + leaves * (LeafModel::getParameterBytes(plane.getLeafModel()) / 3);
+    }
+    return size;
+}
+
+double PlanarQuadTree::getCompressionPercentage() const {
+    size_t originalSize = static_cast<size_t>(width) * height * 3;
+    if (originalSize == 0) {
+        return 0.0;
+    }
+    double compressionRatio = 1.0 - static_cast<double>(getEstimatedCompressedSize()) / originalSize;
+    return std::max(0.0, std::min(1.0, compressionRatio));
+}
+
+const QuadTree& PlanarQuadTree::getPlane(int channel) const {
+    return *planes[channel];
+}
+
+PlanarQuadTree::ChannelMode PlanarQuadTree::getMode() const {
+    return mode;
+}
+
+vector<vector<RGB>> PlanarQuadTree::extractPlane(const vector<vector<RGB>>& image, int channel) const {
+    vector<vector<RGB>> plane(height, vector<RGB>(width));
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const RGB& pixel = image[y][x];
+            unsigned char value;
+            if (mode == YCBCR_PLANES) {
+                value = toYCbCr(pixel, channel);
+            } else {
+                value = channel == 0 ? pixel.getRed() : (channel == 1 ? pixel.getGreen() : pixel.getBlue());
+            }
+            plane[y][x] = RGB(value, value, value);
+        }
+    }
+    return plane;
+}
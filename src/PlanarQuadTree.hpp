@@ -0,0 +1,135 @@
+#ifndef __PLANAR_QUADTREE__HPP__
+#define __PLANAR_QUADTREE__HPP__
+
+#include <memory>
+#include <vector>
+#include "QuadTree.hpp"
+#include "RGB.hpp"
+
+using namespace std;
+
+/**
+ * @class PlanarQuadTree
+ * @brief Kompresi dengan QuadTree terpisah untuk setiap channel (R/G/B atau Y/Cb/Cr)
+ */
+class PlanarQuadTree {
+public:
+
+    enum ChannelMode {
+        JOINT,          // Satu tree untuk ketiga channel (mode bawaan QuadTree)
+        RGB_PLANES,     // Tree terpisah untuk R, G, dan B
+        YCBCR_PLANES    // Tree terpisah untuk luma (Y) dan dua chroma (Cb, Cr)
+    };
+
+private:
+    ChannelMode mode;
+    int width, height;
+    int threadCount;
+    unique_ptr<QuadTree> planes[3];  // Satu QuadTree per channel
+
+public:
+    /**
+     * @brief Constructor untuk PlanarQuadTree
+     * @param Gambar yang akan dikompresi
+     * @param Mode pemisahan channel (RGB_PLANES atau YCBCR_PLANES)
+     * @param Ukuran blok minimum
+     * @param Threshold error
+     * @param Metrik error yang digunakan
+     * @param Jumlah worker thread (0 = jumlah core, maksimal 3)
+     */
+    PlanarQuadTree(const vector<vector<RGB>>&, ChannelMode, int, double,
+                   QuadTree::ErrorMetricType, int = 0);
+
+    /**
+     * @brief Menetapkan peta kepentingan untuk ketiga tree
+     * @param Peta kepentingan (nullptr untuk threshold seragam)
+     */
+    void setImportanceMap(shared_ptr<const ImportanceMap>);
+
+    /**
+     * @brief Menetapkan jenis leaf model untuk ketiga tree
+     * @param Tipe leaf model
+     */
+    void setLeafModel(LeafModel::Type);
+
+    /**
+     * @brief Menetapkan mode partisi untuk ketiga tree
+     * @param Mode partisi
+     */
+    void setPartitionMode(QuadTree::PartitionMode);
+
+    /**
+     * @brief Menyelaraskan potongan ketiga tree ke grid piksel
+     * @param Ukuran grid (0 = nonaktif)
+     */
+    void setSplitGrid(int);
+
+    /**
+     * @brief Membangun ketiga tree secara paralel
+     */
+    void buildTree();
+
+    /**
+     * @brief Menggabungkan hasil ketiga tree menjadi gambar RGB
+     * @return Gambar hasil kompresi
+     */
+    vector<vector<RGB>> getCompressedImage() const;
+
+    /**
+     * @brief Merasterisasi ketiga tree dan menggabungkannya ke buffer interleaved milik pemanggil
+     * @param Buffer berukuran width * height * channel
+     * @param Jumlah channel per piksel (3 = RGB, 4 = RGBA dengan alpha 255)
+     */
+    void rasterize(unsigned char*, int) const;
+
+    /**
+     * @brief Merasterisasi hanya baris [awal, akhir) dari ketiga tree ke buffer band
+     * @param Buffer berukuran width * (akhir - awal) * channel
+     * @param Jumlah channel per piksel (3 = RGB, 4 = RGBA dengan alpha 255)
+     * @param Baris awal (inklusif)
+     * @param Baris akhir (eksklusif)
+     */
+    void rasterizeRows(unsigned char*, int, int, int) const;
+
+    /**
+     * @brief Jumlah node dari ketiga tree
+     */
+    int getNodeCount() const;
+
+    /**
+     * @brief Kedalaman maksimum di antara ketiga tree
+     */
+    int getMaxDepth() const;
+
+    /**
+     * @brief Memperkirakan ukuran data terkompresi (setiap node = 16 byte posisi & ukuran + 1 byte nilai,
+     *        leaf memakai parameter leaf model satu channel)
+     * @return Perkiraan ukuran dalam bytes
+     */
+    size_t getEstimatedCompressedSize() const;
+
+    /**
+     * @brief Menghitung persentase kompresi
+     * @return Persentase kompresi (0.0-1.0)
+     */
+    double getCompressionPercentage() const;
+
+    /**
+     * @brief Mendapatkan tree untuk satu channel
+     * @param Index channel (0-2)
+     */
+    const QuadTree& getPlane(int) const;
+
+    ChannelMode getMode() const;
+
+private:
+    /**
+     * @brief Membuat gambar grayscale (r=g=b) dari satu channel
+     * @param Gambar sumber
+     * @param Index channel pada ruang warna mode ini
+     * @return Gambar satu channel
+     */
+    vector<vector<RGB>> extractPlane(const vector<vector<RGB>>&, int) const;
+};
+
+#endif
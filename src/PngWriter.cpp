@@ -0,0 +1,214 @@
+#include "PngWriter.hpp"
+#include "Deflate.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    const unsigned char SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    const unsigned char FILTER_SUB = 1;
+    const unsigned char FILTER_UP = 2;
+
+    // Header zlib: deflate, window 32K, tanpa dictionary
+    const unsigned char ZLIB_HEADER[2] = { 0x78, 0x01 };
+}
+
+bool PngWriter::encode(int width, int height, int channels, const unsigned char* pixels,
+                       vector<unsigned char>& out, int threadCount) {
+    if (width <= 0 || height <= 0 || !pixels || (channels != 3 && channels != 4)) {
+        std::cerr << "Error: Invalid image for PNG encoding" << std::endl;
+        return false;
+    }
+
+    Format format;
+    format.width = width;
+    format.height = height;
+    format.bitDepth = 8;
+    format.colorType = channels == 4 ? 6 : 2;   // RGBA atau RGB
+    format.rowBytes = static_cast<size_t>(width) * channels;
+    format.bytesPerPixel = channels;
+    encodeRows(format, pixels, vector<RGB>(), out, threadCount);
+    return true;
+}
+
+bool PngWriter::write(const string& path, int width, int height, int channels,
+                      const unsigned char* pixels, int threadCount) {
+    vector<unsigned char> encoded;
+    return encode(width, height, channels, pixels, encoded, threadCount) && writeFile(path, encoded);
+}
+
+bool PngWriter::encodeIndexed(int width, int height, const unsigned char* indices, const vector<RGB>& palette,
+                              vector<unsigned char>& out, int threadCount) {
+    if (width <= 0 || height <= 0 || !indices || palette.empty() || palette.size() > 256) {
+        std::cerr << "Error: Invalid image for indexed PNG encoding" << std::endl;
+        return false;
+    }
+
+    int bitDepth = palette.size() <= 2 ? 1 : palette.size() <= 4 ? 2 : palette.size() <= 16 ? 4 : 8;
+    Format format;
+    format.width = width;
+    format.height = height;
+    format.bitDepth = static_cast<unsigned char>(bitDepth);
+    format.colorType = 3;
+    format.rowBytes = (static_cast<size_t>(width) * bitDepth + 7) / 8;
+    format.bytesPerPixel = 1;
+
+    if (bitDepth == 8) {
+        encodeRows(format, indices, palette, out, threadCount);
+        return true;
+    }
+
+    // Index dikemas beberapa piksel per byte, piksel paling kiri di bit paling tinggi
+    vector<unsigned char> packed(format.rowBytes * height, 0);
+    int pixelsPerByte = 8 / bitDepth;
+    for (int y = 0; y < height; y++) {
+        const unsigned char* source = indices + static_cast<size_t>(y) * width;
+        unsigned char* row = &packed[y * format.rowBytes];
+        for (int x = 0; x < width; x++) {
+            int shift = 8 - bitDepth * (x % pixelsPerByte + 1);
+            row[x / pixelsPerByte] |= static_cast<unsigned char>(source[x] << shift);
+        }
+    }
+    encodeRows(format, packed.data(), palette, out, threadCount);
+    return true;
+}
+
+bool PngWriter::writeIndexed(const string& path, int width, int height, const unsigned char* indices,
+                             const vector<RGB>& palette, int threadCount) {
+    vector<unsigned char> encoded;
+    return encodeIndexed(width, height, indices, palette, encoded, threadCount) && writeFile(path, encoded);
+}
+
+void PngWriter::encodeRows(const Format& format, const unsigned char* rows, const vector<RGB>& palette,
+                           vector<unsigned char>& out, int threadCount) {
+    out.clear();
+    writeHeaderChunks(format, palette, out);
+    uint32_t adler = 1;
+    writeDataChunks(format, rows, format.height, nullptr, true, adler, out, threadCount);
+    writeChunk(out, "IEND", nullptr, 0);
+}
+
+void PngWriter::writeHeaderChunks(const Format& format, const vector<RGB>& palette, vector<unsigned char>& out) {
+    out.insert(out.end(), SIGNATURE, SIGNATURE + 8);
+
+    vector<unsigned char> header;
+    writeUint32(header, format.width);
+    writeUint32(header, format.height);
+    header.push_back(format.bitDepth);
+    header.push_back(format.colorType);
+    header.push_back(0);                        // Kompresi deflate
+    header.push_back(0);                        // Filter adaptif
+    header.push_back(0);                        // Tanpa interlace
+    writeChunk(out, "IHDR", header.data(), header.size());
+
+    if (!palette.empty()) {
+        vector<unsigned char> entries;
+        for (const RGB& color : palette) {
+            entries.push_back(color.getRed());
+            entries.push_back(color.getGreen());
+            entries.push_back(color.getBlue());
+        }
+        writeChunk(out, "PLTE", entries.data(), entries.size());
+    }
+}
+
+void PngWriter::writeDataChunks(const Format& format, const unsigned char* rows, int rowCount,
+                                const unsigned char* previousRow, bool lastRows, uint32_t& adler,
+                                vector<unsigned char>& out, int threadCount) {
+    size_t rowBytes = format.rowBytes;
+    int rowsPerSegment = static_cast<int>(std::max<size_t>(1, SEGMENT_BYTES / (rowBytes + 1)));
+    int segmentCount = (rowCount + rowsPerSegment - 1) / rowsPerSegment;
+    bool firstRows = previousRow == nullptr;
+
+    // Setiap segmen memfilter dan mengompres barisnya sendiri; match tidak melewati batas segmen
+    vector<Segment> segments(segmentCount);
+    Utils::parallelFor(segmentCount, threadCount, [&](int s) {
+        int firstRow = s * rowsPerSegment;
+        int lastRow = std::min(rowCount, firstRow + rowsPerSegment);
+        vector<unsigned char> filtered(static_cast<size_t>(lastRow - firstRow) * (rowBytes + 1));
+        for (int y = firstRow; y < lastRow; y++) {
+            const unsigned char* row = rows + y * rowBytes;
+            const unsigned char* previous = y > 0 ? row - rowBytes : previousRow;
+            filterRow(row, previous, rowBytes, format.bytesPerPixel, &filtered[(y - firstRow) * (rowBytes + 1)]);
+        }
+        Segment& segment = segments[s];
+        segment.adler = Deflate::adler32(filtered.data(), filtered.size());
+        segment.filteredSize = filtered.size();
+        if (s == 0 && firstRows) {
+            segment.compressed.assign(ZLIB_HEADER, ZLIB_HEADER + 2);
+        }
+        Deflate::compress(filtered.data(), filtered.size(), lastRows && s == segmentCount - 1, segment.compressed);
+    });
+
+    // Satu chunk IDAT per segmen; header zlib di chunk pertama, Adler-32 di chunk terakhir
+    for (int s = 0; s < segmentCount; s++) {
+        Segment& segment = segments[s];
+        adler = Deflate::adler32Combine(adler, segment.adler, segment.filteredSize);
+        if (lastRows && s == segmentCount - 1) {
+            writeUint32(segment.compressed, adler);
+        }
+        writeChunk(out, "IDAT", segment.compressed.data(), segment.compressed.size());
+    }
+}
+
+bool PngWriter::writeFile(const string& path, const vector<unsigned char>& encoded) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open " << path << " for writing" << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+    return static_cast<bool>(file);
+}
+
+// Baris identik memakai Up; baris lain memilih Sub atau Up berdasarkan jumlah byte nol
+void PngWriter::filterRow(const unsigned char* row, const unsigned char* previous, size_t rowBytes,
+                          int bytesPerPixel, unsigned char* out) {
+    unsigned char* filtered = out + 1;
+    if (previous && std::memcmp(row, previous, rowBytes) == 0) {
+        out[0] = FILTER_UP;
+        std::memset(filtered, 0, rowBytes);
+        return;
+    }
+
+    size_t subZeros = 0;
+    for (size_t i = 0; i < rowBytes; i++) {
+        unsigned char left = i >= static_cast<size_t>(bytesPerPixel) ? row[i - bytesPerPixel] : 0;
+        filtered[i] = static_cast<unsigned char>(row[i] - left);
+        subZeros += filtered[i] == 0;
+    }
+    out[0] = FILTER_SUB;
+    if (!previous) {
+        return;
+    }
+
+    size_t upZeros = 0;
+    for (size_t i = 0; i < rowBytes; i++) {
+        upZeros += row[i] == previous[i];
+    }
+    if (upZeros > subZeros) {
+        out[0] = FILTER_UP;
+        for (size_t i = 0; i < rowBytes; i++) {
+            filtered[i] = static_cast<unsigned char>(row[i] - previous[i]);
+        }
+    }
+}
+
+void PngWriter::writeChunk(vector<unsigned char>& out, const char* type, const unsigned char* data, size_t size) {
+    writeUint32(out, static_cast<uint32_t>(size));
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (size > 0) {
+        out.insert(out.end(), data, data + size);
+    }
+    writeUint32(out, Deflate::crc32(&out[start], size + 4));
+}
+
+void PngWriter::writeUint32(vector<unsigned char>& out, uint32_t value) {
+    out.push_back(static_cast<unsigned char>(value >> 24));
+    out.push_back(static_cast<unsigned char>(value >> 16));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+    out.push_back(static_cast<unsigned char>(value));
+}
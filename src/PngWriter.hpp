@@ -0,0 +1,135 @@
+#ifndef __PNG_WRITER__HPP__
+#define __PNG_WRITER__HPP__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "RGB.hpp"
+
+using namespace std;
+
+/**
+ * @class PngWriter
+ * @brief Encoder PNG untuk gambar hasil quadtree yang terdiri dari persegi panjang datar.
+ *        Filter dipilih tanpa trial umum: baris yang sama dengan baris sebelumnya memakai Up
+ *        (seluruhnya nol), baris lain memakai Sub atau Up mana yang menghasilkan lebih banyak nol.
+ *        Baris dibagi menjadi segmen yang di-deflate paralel, masing-masing menjadi satu chunk IDAT.
+ *        Gambar dengan palet kecil ditulis sebagai PNG indexed 1/2/4/8-bit
+ */
+class PngWriter {
+public:
+    static const size_t SEGMENT_BYTES = 1 << 20;   // Target ukuran data per segmen paralel
+
+    /**
+     * @brief Mengodekan buffer piksel interleaved menjadi file PNG di memori
+     * @param Lebar gambar
+     * @param Tinggi gambar
+     * @param Jumlah channel (3 = RGB, 4 = RGBA)
+     * @param Buffer piksel, baris berurutan tanpa padding
+     * @param Buffer output
+     * @param Jumlah worker thread (0 = otomatis)
+     * @return true jika berhasil
+     */
+    static bool encode(int, int, int, const unsigned char*, vector<unsigned char>&, int = 0);
+
+    /**
+     * @brief Mengodekan buffer piksel dan menulisnya ke file PNG
+     * @param Path file output
+     * @param Lebar gambar
+     * @param Tinggi gambar
+     * @param Jumlah channel (3 = RGB, 4 = RGBA)
+     * @param Buffer piksel
+     * @param Jumlah worker thread (0 = otomatis)
+     * @return true jika berhasil
+     */
+    static bool write(const string&, int, int, int, const unsigned char*, int = 0);
+
+    /**
+     * @brief Mengodekan gambar index palet menjadi PNG indexed; bit depth terkecil yang memuat palet
+     * @param Lebar gambar
+     * @param Tinggi gambar
+     * @param Buffer index, satu byte per piksel
+     * @param Palet (maksimum 256 warna)
+     * @param Buffer output
+     * @param Jumlah worker thread (0 = otomatis)
+     * @return true jika berhasil
+     */
+    static bool encodeIndexed(int, int, const unsigned char*, const vector<RGB>&, vector<unsigned char>&, int = 0);
+
+    /**
+     * @brief Mengodekan gambar index palet dan menulisnya ke file PNG indexed
+     * @param Path file output
+     * @param Lebar gambar
+     * @param Tinggi gambar
+     * @param Buffer index, satu byte per piksel
+     * @param Palet (maksimum 256 warna)
+     * @param Jumlah worker thread (0 = otomatis)
+     * @return true jika berhasil
+     */
+    static bool writeIndexed(const string&, int, int, const unsigned char*, const vector<RGB>&, int = 0);
+
+private:
+    friend class BandWriter;
+
+    // Parameter IHDR dan layout baris data
+    struct Format {
+        int width, height;
+        unsigned char bitDepth;
+        unsigned char colorType;
+        size_t rowBytes;
+        int bytesPerPixel;      // Jarak filter Sub (minimal 1 byte)
+    };
+
+    // Hasil satu segmen: data deflate dan Adler-32 data hasil filter
+    struct Segment {
+        vector<unsigned char> compressed;
+        uint32_t adler;
+        size_t filteredSize;
+    };
+
+    /**
+     * @brief Memfilter dan mengompres baris secara paralel lalu menyusun file PNG lengkap
+     * @param Format gambar
+     * @param Data baris (rowBytes per baris, tanpa byte filter)
+     * @param Palet untuk chunk PLTE (kosong jika bukan indexed)
+     * @param Buffer output
+     * @param Jumlah worker thread
+     */
+    static void encodeRows(const Format&, const unsigned char*, const vector<RGB>&, vector<unsigned char>&, int);
+
+    /**
+     * @brief Menulis signature, IHDR dan PLTE (jika ada palet)
+     */
+    static void writeHeaderChunks(const Format&, const vector<RGB>&, vector<unsigned char>&);
+
+    /**
+     * @brief Memfilter dan mengompres sekelompok baris secara paralel menjadi chunk IDAT
+     * @param Format gambar
+     * @param Data baris (rowBytes per baris, tanpa byte filter)
+     * @param Jumlah baris
+     * @param Baris sebelum baris pertama (nullptr jika baris pertama gambar)
+     * @param true jika ini baris terakhir gambar (blok BFINAL dan trailer Adler-32)
+     * @param Adler-32 berjalan dari semua data sebelumnya (1 sebelum baris pertama), diperbarui
+     * @param Buffer output
+     * @param Jumlah worker thread
+     */
+    static void writeDataChunks(const Format&, const unsigned char*, int, const unsigned char*, bool,
+                                uint32_t&, vector<unsigned char>&, int);
+
+    static bool writeFile(const string&, const vector<unsigned char>&);
+
+    /**
+     * @brief Memfilter satu baris; byte pertama output adalah tipe filter
+     * @param Baris saat ini
+     * @param Baris sebelumnya (nullptr untuk baris pertama)
+     * @param Jumlah byte per baris
+     * @param Byte per piksel
+     * @param Output (rowBytes + 1 byte)
+     */
+    static void filterRow(const unsigned char*, const unsigned char*, size_t, int, unsigned char*);
+
+    static void writeChunk(vector<unsigned char>&, const char*, const unsigned char*, size_t);
+    static void writeUint32(vector<unsigned char>&, uint32_t);
+};
+
+#endif
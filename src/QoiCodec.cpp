@@ -0,0 +1,227 @@
+#include "QoiCodec.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    const unsigned char MAGIC[4] = { 'q', 'o', 'i', 'f' };
+    const size_t HEADER_SIZE = 14;
+    const unsigned char PADDING[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+    const unsigned char OP_INDEX = 0x00;    // 00xxxxxx
+    const unsigned char OP_DIFF = 0x40;     // 01xxxxxx
+    const unsigned char OP_LUMA = 0x80;     // 10xxxxxx
+    const unsigned char OP_RUN = 0xC0;      // 11xxxxxx
+    const unsigned char OP_RGB = 0xFE;
+    const unsigned char OP_RGBA = 0xFF;
+    const unsigned char MASK_2 = 0xC0;
+    const int MAX_RUN = 62;
+
+    struct Pixel {
+        unsigned char r, g, b, a;
+        bool operator==(const Pixel& other) const {
+            return r == other.r && g == other.g && b == other.b && a == other.a;
+        }
+    };
+
+    inline int hashPixel(const Pixel& p) {
+        return (p.r * 3 + p.g * 5 + p.b * 7 + p.a * 11) % 64;
+    }
+
+    void writeUint32(vector<unsigned char>& out, uint32_t value) {
+        out.push_back(static_cast<unsigned char>(value >> 24));
+        out.push_back(static_cast<unsigned char>(value >> 16));
+        out.push_back(static_cast<unsigned char>(value >> 8));
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    uint32_t readUint32(const unsigned char* data) {
+        return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+             | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+    }
+}
+
+bool QoiCodec::encode(int width, int height, int channels, const unsigned char* pixels, vector<unsigned char>& out) {
+    if (width <= 0 || height <= 0 || !pixels || (channels != 3 && channels != 4) ||
+        static_cast<uint64_t>(width) * height > MAX_PIXELS) {
+        std::cerr << "Error: Invalid image for QOI encoding" << std::endl;
+        return false;
+    }
+
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    out.clear();
+    out.reserve(HEADER_SIZE + pixelCount / 4 + sizeof(PADDING));
+    out.insert(out.end(), MAGIC, MAGIC + 4);
+    writeUint32(out, width);
+    writeUint32(out, height);
+    out.push_back(static_cast<unsigned char>(channels));
+    out.push_back(0);   // sRGB dengan alpha linear
+
+    Pixel index[64];
+    std::memset(index, 0, sizeof(index));
+    Pixel previous = { 0, 0, 0, 255 };
+    int run = 0;
+
+    const unsigned char* source = pixels;
+    for (size_t i = 0; i < pixelCount; i++, source += channels) {
+        Pixel pixel = { source[0], source[1], source[2], channels == 4 ? source[3] : static_cast<unsigned char>(255) };
+
+        if (pixel == previous) {
+            run++;
+            if (run == MAX_RUN || i == pixelCount - 1) {
+                out.push_back(static_cast<unsigned char>(OP_RUN | (run - 1)));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out.push_back(static_cast<unsigned char>(OP_RUN | (run - 1)));
+            run = 0;
+        }
+
+        int hash = hashPixel(pixel);
+        if (index[hash] == pixel) {
+            out.push_back(static_cast<unsigned char>(OP_INDEX | hash));
+        } else {
+            index[hash] = pixel;
+            if (pixel.a == previous.a) {
+                int dr = static_cast<signed char>(pixel.r - previous.r);
+                int dg = static_cast<signed char>(pixel.g - previous.g);
+                int db = static_cast<signed char>(pixel.b - previous.b);
+                int drg = dr - dg;
+                int dbg = db - dg;
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    out.push_back(static_cast<unsigned char>(OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2)));
+                } else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+                    out.push_back(static_cast<unsigned char>(OP_LUMA | (dg + 32)));
+                    out.push_back(static_cast<unsigned char>(((drg + 8) << 4) | (dbg + 8)));
+                } else {
+                    out.push_back(OP_RGB);
+                    out.push_back(pixel.r);
+                    out.push_back(pixel.g);
+                    out.push_back(pixel.b);
+                }
+            } else {
+                out.push_back(OP_RGBA);
+                out.push_back(pixel.r);
+                out.push_back(pixel.g);
+                out.push_back(pixel.b);
+                out.push_back(pixel.a);
+            }
+        }
+        previous = pixel;
+    }
+
+    out.insert(out.end(), PADDING, PADDING + sizeof(PADDING));
+    return true;
+}
+
+bool QoiCodec::encodeToFile(const string& path, int width, int height, int channels, const unsigned char* pixels) {
+    vector<unsigned char> encoded;
+    if (!encode(width, height, channels, pixels, encoded)) {
+        return false;
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open " << path << " for writing" << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+    return static_cast<bool>(file);
+}
+
+bool QoiCodec::decode(const unsigned char* data, size_t size, vector<unsigned char>& pixels,
+                      int& width, int& height, int& channels) {
+    if (size < HEADER_SIZE + sizeof(PADDING) || std::memcmp(data, MAGIC, 4) != 0) {
+        std::cerr << "Error: Invalid QOI header" << std::endl;
+        return false;
+    }
+    uint32_t fileWidth = readUint32(data + 4);
+    uint32_t fileHeight = readUint32(data + 8);
+    int fileChannels = data[12];
+    if (fileWidth == 0 || fileHeight == 0 || (fileChannels != 3 && fileChannels != 4) ||
+        fileWidth > 0x7FFFFFFFu || fileHeight > 0x7FFFFFFFu ||
+        static_cast<uint64_t>(fileWidth) * fileHeight > MAX_PIXELS) {
+        std::cerr << "Error: Invalid QOI header" << std::endl;
+        return false;
+    }
+
+    size_t pixelCount = static_cast<size_t>(fileWidth) * fileHeight;
+    pixels.resize(pixelCount * fileChannels);
+
+    Pixel index[64];
+    std::memset(index, 0, sizeof(index));
+    Pixel pixel = { 0, 0, 0, 255 };
+    size_t position = HEADER_SIZE;
+    size_t end = size - sizeof(PADDING);
+    int run = 0;
+
+    unsigned char* target = pixels.data();
+    for (size_t i = 0; i < pixelCount; i++, target += fileChannels) {
+        if (run > 0) {
+            run--;
+        } else {
+            if (position >= end) {
+                std::cerr << "Error: Truncated QOI data" << std::endl;
+                return false;
+            }
+            unsigned char op = data[position++];
+            if (op == OP_RGB || op == OP_RGBA) {
+                size_t length = op == OP_RGB ? 3 : 4;
+                if (position + length > end) {
+                    std::cerr << "Error: Truncated QOI data" << std::endl;
+                    return false;
+                }
+                pixel.r = data[position];
+                pixel.g = data[position + 1];
+                pixel.b = data[position + 2];
+                if (op == OP_RGBA) {
+                    pixel.a = data[position + 3];
+                }
+                position += length;
+            } else if ((op & MASK_2) == OP_INDEX) {
+                pixel = index[op];
+            } else if ((op & MASK_2) == OP_DIFF) {
+                pixel.r += ((op >> 4) & 0x03) - 2;
+                pixel.g += ((op >> 2) & 0x03) - 2;
+                pixel.b += (op & 0x03) - 2;
+            } else if ((op & MASK_2) == OP_LUMA) {
+                if (position >= end) {
+                    std::cerr << "Error: Truncated QOI data" << std::endl;
+                    return false;
+                }
+                unsigned char second = data[position++];
+                int dg = (op & 0x3F) - 32;
+                pixel.r += dg - 8 + ((second >> 4) & 0x0F);
+                pixel.g += dg;
+                pixel.b += dg - 8 + (second & 0x0F);
+            } else {
+                run = op & 0x3F;
+            }
+            index[hashPixel(pixel)] = pixel;
+        }
+
+        target[0] = pixel.r;
+        target[1] = pixel.g;
+        target[2] = pixel.b;
+        if (fileChannels == 4) {
+            target[3] = pixel.a;
+        }
+    }
+
+    width = static_cast<int>(fileWidth);
+    height = static_cast<int>(fileHeight);
+    channels = fileChannels;
+    return true;
+}
+
+bool QoiCodec::decodeFromFile(const string& path, vector<unsigned char>& pixels, int& width, int& height, int& channels) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open " << path << std::endl;
+        return false;
+    }
+    vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return decode(data.data(), data.size(), pixels, width, height, channels);
+}
@@ -0,0 +1,65 @@
+#ifndef __QOI_CODEC__HPP__
+#define __QOI_CODEC__HPP__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class QoiCodec
+ * @brief Encoder dan decoder format QOI ("Quite OK Image") dalam satu pass linear.
+ *        Run piksel identik (blok datar hasil quadtree) dikodekan sebagai op RUN 1 byte
+ */
+class QoiCodec {
+public:
+    static const uint32_t MAX_PIXELS = 400000000u;  // Batas dari spesifikasi QOI
+
+    /**
+     * @brief Mengodekan buffer piksel interleaved menjadi data QOI
+     * @param Lebar gambar
+     * @param Tinggi gambar
+     * @param Jumlah channel (3 = RGB, 4 = RGBA)
+     * @param Buffer piksel
+     * @param Buffer output
+     * @return true jika berhasil
+     */
+    static bool encode(int, int, int, const unsigned char*, vector<unsigned char>&);
+
+    /**
+     * @brief Mengodekan buffer piksel ke file QOI
+     * @param Path file output
+     * @param Lebar gambar
+     * @param Tinggi gambar
+     * @param Jumlah channel (3 = RGB, 4 = RGBA)
+     * @param Buffer piksel
+     * @return true jika berhasil
+     */
+    static bool encodeToFile(const string&, int, int, int, const unsigned char*);
+
+    /**
+     * @brief Mendekode data QOI menjadi buffer piksel interleaved
+     * @param Data file
+     * @param Ukuran data
+     * @param Buffer piksel output (channel sesuai header)
+     * @param Output lebar gambar
+     * @param Output tinggi gambar
+     * @param Output jumlah channel
+     * @return true jika data valid
+     */
+    static bool decode(const unsigned char*, size_t, vector<unsigned char>&, int&, int&, int&);
+
+    /**
+     * @brief Mendekode file QOI menjadi buffer piksel interleaved
+     * @param Path file input
+     * @param Buffer piksel output
+     * @param Output lebar gambar
+     * @param Output tinggi gambar
+     * @param Output jumlah channel
+     * @return true jika file valid
+     */
+    static bool decodeFromFile(const string&, vector<unsigned char>&, int&, int&, int&);
+};
+
+#endif
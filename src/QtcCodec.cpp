@@ -0,0 +1,469 @@
+#include "QtcCodec.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    const unsigned char MAGIC[4] = { 'Q', 'T', 'C', '1' };
+    const unsigned char PROGRESSIVE_MAGIC[4] = { 'Q', 'T', 'P', '1' };
+    const size_t HEADER_SIZE = 14;  // magic + width + height + partition + leaf model
+    const size_t PROGRESSIVE_HEADER_SIZE = HEADER_SIZE + 2;  // + jumlah level
+
+    inline unsigned char channelValue(const RGB& color, int channel) {
+        if (channel == 0) return color.getRed();
+        if (channel == 1) return color.getGreen();
+        return color.getBlue();
+    }
+
+    // Selisih modulo 256 dipetakan ke 0..255 dengan zigzag (0, -1, 1, -2, ...)
+    inline uint32_t zigzagDelta(unsigned char value, unsigned char reference) {
+        int delta = static_cast<signed char>(static_cast<unsigned char>(value - reference));
+        return delta >= 0 ? static_cast<uint32_t>(2 * delta) : static_cast<uint32_t>(-2 * delta - 1);
+    }
+
+    inline unsigned char applyDelta(uint32_t symbol, unsigned char reference) {
+        int delta = (symbol & 1) ? -static_cast<int>((symbol + 1) / 2) : static_cast<int>(symbol / 2);
+        return static_cast<unsigned char>(reference + delta);
+    }
+
+    void writeUint32(vector<unsigned char>& buffer, uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            buffer.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    uint32_t readUint32(const unsigned char* data) {
+        return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+    }
+}
+
+QtcCodec::Models::Models() {
+    std::fill(split, split + MAX_DEPTH_CONTEXT, RangeEncoder::PROBABILITY_INIT);
+    orientation = RangeEncoder::PROBABILITY_INIT;
+}
+
+int QtcCodec::bitsFor(int value) {
+    int bits = 1;
+    while ((value >> bits) != 0) {
+        bits++;
+    }
+    return bits;
+}
+
+// Potongan quadrant yang diselaraskan ke grid bukan titik tengah, sehingga offset ditulis eksplisit
+QuadTree::PartitionMode QtcCodec::streamPartition(const QuadTree& tree) {
+    if (tree.getPartitionMode() == QuadTree::QUADRANT && tree.getSplitGrid() > 0) {
+        return QuadTree::ADAPTIVE_QUAD;
+    }
+    return tree.getPartitionMode();
+}
+
+void QtcCodec::writeHeader(const unsigned char* magic, const QuadTree& tree, vector<unsigned char>& output) {
+    output.assign(magic, magic + 4);
+    writeUint32(output, tree.getWidth());
+    writeUint32(output, tree.getHeight());
+    output.push_back(static_cast<unsigned char>(streamPartition(tree)));
+    output.push_back(static_cast<unsigned char>(tree.getLeafModel()));
+}
+
+bool QtcCodec::readHeader(const unsigned char* magic, const unsigned char* data, size_t size, StreamInfo& info) {
+    if (size < HEADER_SIZE || !std::equal(magic, magic + 4, data)) {
+        std::cerr << "Error: Not a ." << (magic == MAGIC ? "qtc" : "qtp") << " file" << std::endl;
+        return false;
+    }
+
+    uint32_t width = readUint32(data + 4);
+    uint32_t height = readUint32(data + 8);
+    int partition = data[12];
+    int leafModel = data[13];
+    if (width == 0 || height == 0 || width > 65535 || height > 65535 ||
+        partition > QuadTree::ADAPTIVE_QUAD || leafModel > LeafModel::BILINEAR) {
+        std::cerr << "Error: Invalid quadtree file header" << std::endl;
+        return false;
+    }
+
+    info.width = width;
+    info.height = height;
+    info.partition = static_cast<QuadTree::PartitionMode>(partition);
+    info.leafModel = static_cast<LeafModel::Type>(leafModel);
+    return true;
+}
+
+// ==================== Data satu node ====================
+
+// Urutan: warna node, flag split, lalu geometri potongan atau parameter leaf model
+void QtcCodec::encodeNodeData(RangeEncoder& encoder, Models& models, const Node* node, const RGB& parentColor,
+                              int depth, QuadTree::PartitionMode partition, LeafModel::Type leafModel) {
+    const RGB& color = node->getAvgColor();
+    for (int c = 0; c < 3; c++) {
+        encoder.encodeSymbol(models.color[c], zigzagDelta(channelValue(color, c), channelValue(parentColor, c)));
+    }
+
+    int context = std::min(depth, MAX_DEPTH_CONTEXT - 1);
+    encoder.encodeBit(models.split[context], node->getIsLeaf() ? 0 : 1);
+
+    const Block& region = node->getRegion();
+    if (node->getIsLeaf()) {
+        const LeafModel* model = node->getModel();
+        if (leafModel != LeafModel::FLAT && model) {
+            for (int i = 0; i < model->getCornerCount(); i++) {
+                for (int c = 0; c < 3; c++) {
+                    encoder.encodeSymbol(models.corner[c],
+                        zigzagDelta(channelValue(model->getCorner(i), c), channelValue(color, c)));
+                }
+            }
+        }
+        return;
+    }
+
+    if (partition == QuadTree::ADAPTIVE_BINARY) {
+        bool vertical = node->getSplitY() == region.getHeight();
+        encoder.encodeBit(models.orientation, vertical ? 0 : 1);
+        if (vertical) {
+            encoder.encodeDirectBits(node->getSplitX() - 1, bitsFor(region.getWidth() - 2));
+        } else {
+            encoder.encodeDirectBits(node->getSplitY() - 1, bitsFor(region.getHeight() - 2));
+        }
+    } else if (partition == QuadTree::ADAPTIVE_QUAD) {
+        encoder.encodeDirectBits(node->getSplitX(), bitsFor(region.getWidth()));
+        encoder.encodeDirectBits(node->getSplitY(), bitsFor(region.getHeight()));
+    }
+}
+
+bool QtcCodec::decodeNodeData(RangeDecoder& decoder, Models& models, const Block& region, const RGB& parentColor,
+                              int depth, const StreamInfo& info, DecodedNode& node) {
+    unsigned char values[3];
+    for (int c = 0; c < 3; c++) {
+        values[c] = applyDelta(decoder.decodeSymbol(models.color[c]), channelValue(parentColor, c));
+    }
+    node.region = region;
+    node.color = RGB(values[0], values[1], values[2]);
+
+    int context = std::min(depth, MAX_DEPTH_CONTEXT - 1);
+    node.isLeaf = decoder.decodeBit(models.split[context]) == 0;
+
+    int width = region.getWidth(), height = region.getHeight();
+    node.splitX = width / 2;
+    node.splitY = height / 2;
+
+    if (node.isLeaf) {
+        node.model = LeafModel::create(info.leafModel);
+        if (node.model) {
+            RGB corners[4];
+            for (int i = 0; i < node.model->getCornerCount(); i++) {
+                unsigned char cornerValues[3];
+                for (int c = 0; c < 3; c++) {
+                    cornerValues[c] = applyDelta(decoder.decodeSymbol(models.corner[c]), values[c]);
+                }
+                corners[i] = RGB(cornerValues[0], cornerValues[1], cornerValues[2]);
+            }
+            node.model->setCorners(region, corners);
+        }
+        return !decoder.isExhausted();
+    }
+
+    if (info.partition == QuadTree::ADAPTIVE_BINARY) {
+        if (decoder.decodeBit(models.orientation) == 0) {
+            if (width < 2) return false;
+            node.splitX = decoder.decodeDirectBits(bitsFor(width - 2)) + 1;
+            node.splitY = height;
+        } else {
+            if (height < 2) return false;
+            node.splitX = width;
+            node.splitY = decoder.decodeDirectBits(bitsFor(height - 2)) + 1;
+        }
+    } else if (info.partition == QuadTree::ADAPTIVE_QUAD) {
+        node.splitX = decoder.decodeDirectBits(bitsFor(width));
+        node.splitY = decoder.decodeDirectBits(bitsFor(height));
+    }
+    if (node.splitX < 0 || node.splitX > width || node.splitY < 0 || node.splitY > height) {
+        return false;
+    }
+
+    // Setiap anak harus lebih kecil dari parent, dan minimal satu anak tidak kosong
+    bool anyChild = false;
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        long long area = region.getQuadrant(quadrant, node.splitX, node.splitY).getArea();
+        if (area >= region.getArea()) {
+            return false;
+        }
+        anyChild = anyChild || area > 0;
+    }
+    return anyChild && !decoder.isExhausted();
+}
+
+void QtcCodec::paintNode(const DecodedNode& node, vector<vector<RGB>>& image) {
+    int startX = node.region.getX(), startY = node.region.getY();
+    int endX = startX + node.region.getWidth(), endY = startY + node.region.getHeight();
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            image[y][x] = node.model ? node.model->predict(x, y) : node.color;
+        }
+    }
+}
+
+// ==================== .qtc (preorder) ====================
+
+bool QtcCodec::encode(const QuadTree& tree, vector<unsigned char>& output) {
+    const Node* root = tree.getRoot();
+    if (!root) {
+        std::cerr << "Error: QuadTree must be built before encoding" << std::endl;
+        return false;
+    }
+    if (tree.getWidth() > 65535 || tree.getHeight() > 65535) {
+        std::cerr << "Error: Quadtree files support images up to 65535x65535" << std::endl;
+        return false;
+    }
+
+    writeHeader(MAGIC, tree, output);
+
+    RangeEncoder encoder;
+    Models models;
+    encodeNode(encoder, models, root, RGB(128, 128, 128), 0, streamPartition(tree), tree.getLeafModel());
+    encoder.flush();
+
+    const vector<unsigned char>& payload = encoder.getOutput();
+    output.insert(output.end(), payload.begin(), payload.end());
+    return true;
+}
+
+bool QtcCodec::encodeToFile(const QuadTree& tree, const string& path) {
+    vector<unsigned char> buffer;
+    return encode(tree, buffer) && writeFile(path, buffer);
+}
+
+void QtcCodec::encodeNode(RangeEncoder& encoder, Models& models, const Node* node, const RGB& parentColor,
+                          int depth, QuadTree::PartitionMode partition, LeafModel::Type leafModel) {
+    encodeNodeData(encoder, models, node, parentColor, depth, partition, leafModel);
+    if (node->getIsLeaf()) {
+        return;
+    }
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        const Node* child = node->getChild(quadrant);
+        if (child) {
+            encodeNode(encoder, models, child, node->getAvgColor(), depth + 1, partition, leafModel);
+        }
+    }
+}
+
+bool QtcCodec::decode(const unsigned char* data, size_t size, vector<vector<RGB>>& image) {
+    StreamInfo info;
+    if (!readHeader(MAGIC, data, size, info)) {
+        return false;
+    }
+
+    image.assign(info.height, vector<RGB>(info.width));
+    RangeDecoder decoder(data + HEADER_SIZE, size - HEADER_SIZE);
+    Models models;
+    bool valid = decodeNode(decoder, models, Block(0, 0, info.width, info.height), RGB(128, 128, 128), 0,
+                            info, image);
+    if (!valid || decoder.isExhausted()) {
+        std::cerr << "Error: Corrupt or truncated .qtc data" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool QtcCodec::decodeFromFile(const string& path, vector<vector<RGB>>& image) {
+    vector<unsigned char> buffer;
+    return readFile(path, buffer) && decode(buffer.data(), buffer.size(), image);
+}
+
+bool QtcCodec::decodeNode(RangeDecoder& decoder, Models& models, const Block& region, const RGB& parentColor,
+                          int depth, const StreamInfo& info, vector<vector<RGB>>& image) {
+    DecodedNode node;
+    if (!decodeNodeData(decoder, models, region, parentColor, depth, info, node)) {
+        return false;
+    }
+    if (node.isLeaf) {
+        paintNode(node, image);
+        return true;
+    }
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        Block child = region.getQuadrant(quadrant, node.splitX, node.splitY);
+        if (child.getArea() > 0 && !decodeNode(decoder, models, child, node.color, depth + 1, info, image)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ==================== .qtp (progresif per level) ====================
+
+// Setiap level ditulis sebagai chunk [panjang u32][payload range coder] berisi maksimal
+// NODES_PER_CHUNK node. Model probabilitas berlanjut antar chunk, range coder di-flush per chunk
+bool QtcCodec::encodeProgressive(const QuadTree& tree, vector<unsigned char>& output, size_t maxBytes) {
+    const Node* root = tree.getRoot();
+    if (!root) {
+        std::cerr << "Error: QuadTree must be built before encoding" << std::endl;
+        return false;
+    }
+    if (tree.getWidth() > 65535 || tree.getHeight() > 65535) {
+        std::cerr << "Error: Quadtree files support images up to 65535x65535" << std::endl;
+        return false;
+    }
+
+    writeHeader(PROGRESSIVE_MAGIC, tree, output);
+    int levelCount = std::min(tree.getMaxDepth() + 1, 65535);
+    output.push_back(static_cast<unsigned char>(levelCount & 0xFF));
+    output.push_back(static_cast<unsigned char>(levelCount >> 8));
+    if (maxBytes > 0 && output.size() > maxBytes) {
+        std::cerr << "Error: Byte limit " << maxBytes << " is smaller than the file header" << std::endl;
+        return false;
+    }
+
+    Models models;
+    vector<const Node*> level(1, root);
+    vector<RGB> parentColors(1, RGB(128, 128, 128));
+
+    for (int depth = 0; !level.empty(); depth++) {
+        vector<const Node*> nextLevel;
+        vector<RGB> nextParentColors;
+
+        for (size_t start = 0; start < level.size(); start += NODES_PER_CHUNK) {
+            size_t end = std::min(level.size(), start + static_cast<size_t>(NODES_PER_CHUNK));
+            RangeEncoder encoder;
+            for (size_t i = start; i < end; i++) {
+                encodeNodeData(encoder, models, level[i], parentColors[i], depth,
+                               streamPartition(tree), tree.getLeafModel());
+            }
+            encoder.flush();
+
+            // Berhenti pada chunk pertama yang tidak muat, file tetap valid
+            const vector<unsigned char>& payload = encoder.getOutput();
+            if (maxBytes > 0 && output.size() + 4 + payload.size() > maxBytes) {
+                return true;
+            }
+            writeUint32(output, static_cast<uint32_t>(payload.size()));
+            output.insert(output.end(), payload.begin(), payload.end());
+        }
+
+        for (const Node* node : level) {
+            if (node->getIsLeaf()) {
+                continue;
+            }
+            for (int quadrant = 0; quadrant < 4; quadrant++) {
+                if (node->getChild(quadrant)) {
+                    nextLevel.push_back(node->getChild(quadrant));
+                    nextParentColors.push_back(node->getAvgColor());
+                }
+            }
+        }
+        level.swap(nextLevel);
+        parentColors.swap(nextParentColors);
+    }
+    return true;
+}
+
+bool QtcCodec::encodeProgressiveToFile(const QuadTree& tree, const string& path, size_t maxBytes) {
+    vector<unsigned char> buffer;
+    return encodeProgressive(tree, buffer, maxBytes) && writeFile(path, buffer);
+}
+
+// Setiap node yang tiba langsung digambar, lalu ditimpa oleh anak-anaknya pada level berikutnya
+bool QtcCodec::decodeProgressive(const unsigned char* data, size_t size, vector<vector<RGB>>& image,
+                                 int* completeLevels) {
+    StreamInfo info;
+    if (!readHeader(PROGRESSIVE_MAGIC, data, size, info) || size < PROGRESSIVE_HEADER_SIZE) {
+        return false;
+    }
+    int levelCount = data[HEADER_SIZE] | (data[HEADER_SIZE + 1] << 8);
+
+    image.assign(info.height, vector<RGB>(info.width, RGB(128, 128, 128)));
+    if (completeLevels) {
+        *completeLevels = 0;
+    }
+
+    Models models;
+    vector<Block> level(1, Block(0, 0, info.width, info.height));
+    vector<RGB> parentColors(1, RGB(128, 128, 128));
+    size_t position = PROGRESSIVE_HEADER_SIZE;
+
+    for (int depth = 0; !level.empty(); depth++) {
+        vector<Block> nextLevel;
+        vector<RGB> nextParentColors;
+
+        for (size_t start = 0; start < level.size(); start += NODES_PER_CHUNK) {
+            size_t end = std::min(level.size(), start + static_cast<size_t>(NODES_PER_CHUNK));
+            if (position + 4 > size) {
+                return true;
+            }
+            size_t length = readUint32(data + position);
+            if (length > size - position - 4) {
+                return true;  // Chunk terpotong
+            }
+
+            // Chunk hanya diterapkan jika seluruh node di dalamnya valid
+            RangeDecoder decoder(data + position + 4, length);
+            vector<DecodedNode> nodes(end - start);
+            for (size_t i = start; i < end; i++) {
+                if (!decodeNodeData(decoder, models, level[i], parentColors[i], depth, info, nodes[i - start])) {
+                    std::cerr << "Warning: Corrupt .qtp chunk at level " << depth << ", decoding stopped" << std::endl;
+                    return true;
+                }
+            }
+            position += 4 + length;
+
+            for (const DecodedNode& node : nodes) {
+                paintNode(node, image);
+                if (node.isLeaf) {
+                    continue;
+                }
+                for (int quadrant = 0; quadrant < 4; quadrant++) {
+                    Block child = node.region.getQuadrant(quadrant, node.splitX, node.splitY);
+                    if (child.getArea() > 0) {
+                        nextLevel.push_back(child);
+                        nextParentColors.push_back(node.color);
+                    }
+                }
+            }
+        }
+
+        if (completeLevels) {
+            *completeLevels = std::min(depth + 1, levelCount);
+        }
+        level.swap(nextLevel);
+        parentColors.swap(nextParentColors);
+    }
+    return true;
+}
+
+bool QtcCodec::decodeProgressiveFromFile(const string& path, vector<vector<RGB>>& image) {
+    vector<unsigned char> buffer;
+    if (!readFile(path, buffer)) {
+        return false;
+    }
+    int completeLevels = 0;
+    if (!decodeProgressive(buffer.data(), buffer.size(), image, &completeLevels)) {
+        return false;
+    }
+    int levelCount = buffer[HEADER_SIZE] | (buffer[HEADER_SIZE + 1] << 8);
+    if (completeLevels < levelCount) {
+        std::cout << "Partial .qtp stream: " << completeLevels << " of " << levelCount
+                  << " levels complete" << std::endl;
+    }
+    return true;
+}
+
+// ==================== File I/O ====================
+
+bool QtcCodec::writeFile(const string& path, const vector<unsigned char>& buffer) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open " << path << " for writing" << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    return static_cast<bool>(file);
+}
+
+bool QtcCodec::readFile(const string& path, vector<unsigned char>& buffer) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open " << path << std::endl;
+        return false;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
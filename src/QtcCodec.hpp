@@ -0,0 +1,163 @@
+#ifndef __QTC_CODEC__HPP__
+#define __QTC_CODEC__HPP__
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "QuadTree.hpp"
+#include "RangeCoder.hpp"
+#include "RGB.hpp"
+
+using namespace std;
+
+/**
+ * @class QtcCodec
+ * @brief Format native tree yang di-range-code. Setiap node menyimpan warna rata-rata sebagai
+ *        delta terhadap parent dan flag split; geometri implisit dari flag split (offset potongan
+ *        ditulis hanya untuk partisi adaptif).
+ *        - .qtc: urutan preorder, satu stream range coder (paling ringkas)
+ *        - .qtp: urutan per level (breadth-first) dalam chunk yang di-flush terpisah, sehingga
+ *          setiap prefix file tetap dapat didekode menjadi gambar yang lebih kasar
+ */
+class QtcCodec {
+public:
+    static const int MAX_DEPTH_CONTEXT = 32;
+    static const int NODES_PER_CHUNK = 4096;   // Jumlah node per chunk progresif
+
+    /**
+     * @brief Mengodekan QuadTree yang sudah dibangun ke buffer .qtc
+     * @param QuadTree sumber
+     * @param Buffer output
+     * @return true jika berhasil
+     */
+    static bool encode(const QuadTree&, vector<unsigned char>&);
+
+    /**
+     * @brief Mengodekan QuadTree ke file .qtc
+     * @param QuadTree sumber
+     * @param Path file output
+     * @return true jika berhasil
+     */
+    static bool encodeToFile(const QuadTree&, const string&);
+
+    /**
+     * @brief Mendekode buffer .qtc menjadi gambar
+     * @param Data file
+     * @param Ukuran data
+     * @param Gambar hasil dekode
+     * @return true jika berhasil
+     */
+    static bool decode(const unsigned char*, size_t, vector<vector<RGB>>&);
+
+    /**
+     * @brief Mendekode file .qtc menjadi gambar
+     * @param Path file input
+     * @param Gambar hasil dekode
+     * @return true jika berhasil
+     */
+    static bool decodeFromFile(const string&, vector<vector<RGB>>&);
+
+    /**
+     * @brief Mengodekan QuadTree per level ke buffer .qtp
+     * @param QuadTree sumber
+     * @param Buffer output
+     * @param Batas ukuran file dalam byte (0 = tanpa batas); chunk yang tidak muat dibuang
+     * @return true jika berhasil
+     */
+    static bool encodeProgressive(const QuadTree&, vector<unsigned char>&, size_t = 0);
+
+    /**
+     * @brief Mengodekan QuadTree per level ke file .qtp
+     * @param QuadTree sumber
+     * @param Path file output
+     * @param Batas ukuran file dalam byte (0 = tanpa batas)
+     * @return true jika berhasil
+     */
+    static bool encodeProgressiveToFile(const QuadTree&, const string&, size_t = 0);
+
+    /**
+     * @brief Mendekode prefix buffer .qtp; node yang belum tiba digambar dengan warna parent
+     * @param Data file (boleh terpotong setelah header)
+     * @param Ukuran data
+     * @param Gambar hasil dekode
+     * @param Output jumlah level yang lengkap (opsional)
+     * @return true jika header valid
+     */
+    static bool decodeProgressive(const unsigned char*, size_t, vector<vector<RGB>>&, int* = nullptr);
+
+    /**
+     * @brief Mendekode file .qtp (boleh terpotong) menjadi gambar
+     * @param Path file input
+     * @param Gambar hasil dekode
+     * @return true jika header valid
+     */
+    static bool decodeProgressiveFromFile(const string&, vector<vector<RGB>>&);
+
+private:
+    // Model probabilitas adaptif, identik di encoder dan decoder
+    struct Models {
+        uint16_t split[MAX_DEPTH_CONTEXT];
+        uint16_t orientation;
+        BitTreeModel color[3];
+        BitTreeModel corner[3];
+        Models();
+    };
+
+    // Parameter stream yang dibaca dari header
+    struct StreamInfo {
+        int width, height;
+        QuadTree::PartitionMode partition;
+        LeafModel::Type leafModel;
+    };
+
+    // Hasil dekode satu node
+    struct DecodedNode {
+        Block region;
+        RGB color;
+        bool isLeaf;
+        int splitX, splitY;
+        unique_ptr<LeafModel> model;
+    };
+
+    /**
+     * @brief Mode partisi yang ditulis ke stream (menentukan apakah offset potongan disimpan)
+     */
+    static QuadTree::PartitionMode streamPartition(const QuadTree&);
+
+    static void writeHeader(const unsigned char*, const QuadTree&, vector<unsigned char>&);
+    static bool readHeader(const unsigned char*, const unsigned char*, size_t, StreamInfo&);
+
+    /**
+     * @brief Menulis data satu node (warna, flag split, geometri atau parameter leaf)
+     */
+    static void encodeNodeData(RangeEncoder&, Models&, const Node*, const RGB&, int,
+                               QuadTree::PartitionMode, LeafModel::Type);
+
+    /**
+     * @brief Membaca data satu node, pasangan encodeNodeData
+     * @return false jika data tidak valid
+     */
+    static bool decodeNodeData(RangeDecoder&, Models&, const Block&, const RGB&, int,
+                               const StreamInfo&, DecodedNode&);
+
+    static void encodeNode(RangeEncoder&, Models&, const Node*, const RGB&, int,
+                           QuadTree::PartitionMode, LeafModel::Type);
+
+    static bool decodeNode(RangeDecoder&, Models&, const Block&, const RGB&, int,
+                           const StreamInfo&, vector<vector<RGB>>&);
+
+    /**
+     * @brief Mengisi region node dengan warna rata-rata atau prediksi leaf model
+     */
+    static void paintNode(const DecodedNode&, vector<vector<RGB>>&);
+
+    /**
+     * @brief Jumlah bit untuk menyimpan nilai 0..n
+     */
+    static int bitsFor(int);
+
+    static bool writeFile(const string&, const vector<unsigned char>&);
+    static bool readFile(const string&, vector<unsigned char>&);
+};
+
+#endif
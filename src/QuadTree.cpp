@@ -1,14 +1,31 @@
 #include "QuadTree.hpp"
 #include "ErrorMetrics.hpp"
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
+namespace {
+    inline uint32_t packColor(const RGB& color) {
+        return (static_cast<uint32_t>(color.getRed()) << 16) | (static_cast<uint32_t>(color.getGreen()) << 8)
+             | color.getBlue();
+    }
+}
+
 // Constructor
 QuadTree::QuadTree(const vector<vector<RGB>>& _image, int _minBlockSize, double _threshold, 
     ErrorMetricType _errorMetric)
-    : image(_image), minBlockSize(_minBlockSize), threshold(_threshold), 
-    errorMetric(_errorMetric), nodeCount(0), maxDepth(0), root(nullptr) {
-        this->maxDepth = maxDepth;
+    : QuadTree(make_shared<ImageStatistics>(make_shared<const vector<vector<RGB>>>(_image)),
+               _minBlockSize, _threshold, _errorMetric) {
+}
+
+// Constructor dengan statistik gambar yang dipakai bersama
+QuadTree::QuadTree(shared_ptr<const ImageStatistics> _statistics, int _minBlockSize, double _threshold, 
+    ErrorMetricType _errorMetric)
+    : root(nullptr), statistics(_statistics), image(_statistics->getImage()),
+    minBlockSize(_minBlockSize), threshold(_threshold), 
+    errorMetric(_errorMetric), nodeCount(0), leafCount(0), maxDepth(0), nodeProcessedCount(0),
+    leafModel(LeafModel::FLAT), partitionMode(QUADRANT), splitGrid(0), recordSplits(false) {
 }
 
 // Membangun QuadTree dengan pendekatan divide and conquer
@@ -24,17 +41,17 @@ void QuadTree::buildTree() {
     int height = image.size();
     Block fullImageBlock(0, 0, width, height);
     
-    // Hitung warna rata-rata untuk seluruh gambar
-    RGB avgColor = calculateAverageColor(fullImageBlock);
-    
-    // Buat root node
-    root = make_unique<Node>(fullImageBlock, avgColor);
+    // Buat root node beserta warna rata-rata seluruh gambar
+    root = createNode(fullImageBlock);
     
     // Mulai proses subdivisi dari root node
+    nodeProcessedCount = 0;
+    splitLog.clear();
     subdivide(root.get(), 0);
     
     // Hitung jumlah node dan kedalaman maksimum
     nodeCount = countNodes(root.get());
+    leafCount = countLeaves(root.get());
     maxDepth = calculateMaxDepth(root.get(), 0);
 }
 
@@ -56,11 +73,70 @@ vector<vector<RGB>> QuadTree::getCompressedImage() const {
     return result;
 }
 
+// Merasterisasi tree ke buffer milik pemanggil tanpa gambar perantara
+void QuadTree::rasterize(unsigned char* buffer, int channels) const {
+    if (!root || !buffer) {
+        return;
+    }
+    rasterizeNode(buffer, channels, root.get(), 0, getHeight());
+}
+
+void QuadTree::rasterizeRows(unsigned char* buffer, int channels, int firstRow, int lastRow) const {
+    if (!root || !buffer || firstRow >= lastRow) {
+        return;
+    }
+    rasterizeNode(buffer, channels, root.get(), firstRow, lastRow);
+}
+
+void QuadTree::rasterizeScaled(unsigned char* buffer, int channels, int targetWidth, int targetHeight) const {
+    if (!root || !buffer || targetWidth <= 0 || targetHeight <= 0) {
+        return;
+    }
+    rasterizeScaledNode(buffer, channels, root.get(), targetWidth, targetHeight);
+}
+
+bool QuadTree::getLeafPalette(vector<RGB>& palette, size_t maxColors) const {
+    palette.clear();
+    if (!root) {
+        return false;
+    }
+    unordered_map<uint32_t, unsigned char> lookup;
+    return collectLeafColors(root.get(), palette, lookup, std::min<size_t>(maxColors, 256));
+}
+
+void QuadTree::rasterizeIndices(unsigned char* buffer, const vector<RGB>& palette) const {
+    if (!root || !buffer) {
+        return;
+    }
+    unordered_map<uint32_t, unsigned char> lookup;
+    for (size_t i = 0; i < palette.size() && i < 256; i++) {
+        lookup[packColor(palette[i])] = static_cast<unsigned char>(i);
+    }
+    rasterizeNode(buffer, 1, root.get(), 0, getHeight(), &lookup);
+}
+
 // Getter untuk jumlah node
 int QuadTree::getNodeCount() const {
     return nodeCount;
 }
 
+const Node* QuadTree::getRoot() const {
+    return root.get();
+}
+
+int QuadTree::getWidth() const {
+    return image.empty() ? 0 : image[0].size();
+}
+
+int QuadTree::getHeight() const {
+    return image.size();
+}
+
+// Getter untuk jumlah leaf node
+int QuadTree::getLeafCount() const {
+    return leafCount;
+}
+
 // Getter untuk kedalaman maksimum
 int QuadTree::getMaxDepth() const {
     return maxDepth;
@@ -72,7 +148,7 @@ double QuadTree::getCompressionPercentage() const {
     size_t originalSize = image.size() * image[0].size() * 3;
     
     // Ukuran terkompresi (setiap node leaf = 3 byte untuk warna + 16 byte untuk posisi & ukuran)
-    size_t compressedSize = nodeCount * (3 + 16);
+    size_t compressedSize = getEstimatedCompressedSize();
     
     // Hitung persentase kompresi
     double compressionRatio = 1.0 - (static_cast<double>(compressedSize) / originalSize);
@@ -81,6 +157,13 @@ double QuadTree::getCompressionPercentage() const {
     return std::max(0.0, std::min(1.0, compressionRatio));
 }
 
+// Memperkirakan ukuran data terkompresi
+size_t QuadTree::getEstimatedCompressedSize() const {
+    size_t internalCount = static_cast<size_t>(nodeCount - leafCount);
+    return static_cast<size_t>(nodeCount) * 16 + internalCount * 3
+         + static_cast<size_t>(leafCount) * LeafModel::getParameterBytes(leafModel);
+}
+
 // Menetapkan callback untuk visualisasi proses kompresi
 void QuadTree::setCompressionCallback(CompressionCallback callback) {
     compressionCallback = callback;
@@ -109,56 +192,70 @@ vector<vector<RGB>> QuadTree::getCurrentStateImage() const {
 // Membagi node dengan pendekatan divide and conquer
 void QuadTree::subdivide(Node* node, int depth) {
     if (!node) return;
-    static int nodeProcessedCount = 0;
     
     // Hitung error untuk region saat ini
-    double error = calculateError(node->region, node->avgColor);
+    double error = node->model ? calculateError(*node->model)
+                               : calculateError(node->region, node->avgColor);
 
     // if (error > 1000000 || error < 0) { // Deteksi nilai ekstrem   //DEBUGGING
     //     std::cerr << "Warning: Extreme error value " << error 
     //               << " for method " << errorMetric << std::endl;
     // }
     
-    // Tentukan apakah perlu subdivisi
-    bool shouldSubdivide = error > threshold;
-    int subBlockWidth = node->region.getWidth() / 2;
-    int subBlockHeight = node->region.getHeight() / 2;
-    
-    // Calculate area of potential sub-blocks
-    int subBlockArea = subBlockWidth * subBlockHeight;
+    // Threshold lokal diskalakan oleh peta kepentingan jika ada
+    double localThreshold = threshold;
+    if (importanceMap) {
+        localThreshold *= importanceMap->getThresholdScale(node->region);
+    }
     
-    // Periksa ukuran minimum blok
-    if (subBlockArea < minBlockSize) {
-        shouldSubdivide = false;
+    // Tentukan apakah perlu subdivisi
+    bool shouldSubdivide = error > localThreshold;
+    int width = node->region.getWidth();
+    int height = node->region.getHeight();
+    int splitX = snapToGrid(node->region.getX(), width, width / 2, splitGrid);
+    int splitY = snapToGrid(node->region.getY(), height, height / 2, splitGrid);
+    
+    if (shouldSubdivide && partitionMode != QUADRANT) {
+        shouldSubdivide = chooseSplit(node->region, splitX, splitY);
+    } else {
+        // Calculate area of potential sub-blocks (potongan grid bisa tidak simetris)
+        int subBlockArea = std::min(splitX, width - splitX) * std::min(splitY, height - splitY);
+        
+        // Periksa ukuran minimum blok
+        if (subBlockArea < minBlockSize) {
+            shouldSubdivide = false;
+        }
     }
     
     if (shouldSubdivide) {
         nodeProcessedCount++;
         // Ubah status node menjadi internal (bukan leaf)
         node->isLeaf = false;
+        node->model.reset();
+        node->splitX = splitX;
+        node->splitY = splitY;
         
-        // Buat sub-regions untuk 4 kuadran
-        Block topLeftRegion = node->region.getQuadrant(0);
-        Block topRightRegion = node->region.getQuadrant(1);
-        Block bottomLeftRegion = node->region.getQuadrant(2);
-        Block bottomRightRegion = node->region.getQuadrant(3);
-        
-        // Hitung warna rata-rata untuk setiap kuadran
-        RGB topLeftColor = calculateAverageColor(topLeftRegion);
-        RGB topRightColor = calculateAverageColor(topRightRegion);
-        RGB bottomLeftColor = calculateAverageColor(bottomLeftRegion);
-        RGB bottomRightColor = calculateAverageColor(bottomRightRegion);
-        
-        // Buat child nodes
-        node->topLeft = make_unique<Node>(topLeftRegion, topLeftColor);
-        node->topRight = make_unique<Node>(topRightRegion, topRightColor);
-        node->bottomLeft = make_unique<Node>(bottomLeftRegion, bottomLeftColor);
-        node->bottomRight = make_unique<Node>(bottomRightRegion, bottomRightColor);
+        // Buat child nodes, potongan biner hanya menghasilkan 2 anak
+        for (int quadrant = 0; quadrant < 4; quadrant++) {
+            Block childRegion = node->region.getQuadrant(quadrant, splitX, splitY);
+            if (childRegion.getArea() > 0) {
+                node->getChildSlot(quadrant) = createNode(childRegion);
+            }
+        }
         
-        // Panggil callback untuk visualisasi jika tersedia
-        if (compressionRegionCallback && nodeProcessedCount % 100 == 0) {
-            compressionRegionCallback(node->region, node->avgColor);
-        }        
+        // Catat split untuk replay visualisasi
+        if (recordSplits) {
+            SplitEvent event;
+            event.region = node->region;
+            event.depth = depth;
+            event.splitX = splitX;
+            event.splitY = splitY;
+            for (int quadrant = 0; quadrant < 4; quadrant++) {
+                const Node* child = node->getChild(quadrant);
+                event.childColors[quadrant] = child ? child->avgColor : RGB();
+            }
+            splitLog.push_back(event);
+        }
         
         // Rekursif subdivisi child nodes
         subdivide(node->topLeft.get(), depth + 1);
@@ -168,46 +265,107 @@ void QuadTree::subdivide(Node* node, int depth) {
     }
 }
 
-// Menghitung warna rata-rata dari region
-RGB QuadTree::calculateAverageColor(const Block& region) const {
-    int width = region.getWidth();
-    int height = region.getHeight();
-    int startX = region.getX();
-    int startY = region.getY();
-    
-    if (width <= 0 || height <= 0 || 
-        startX >= image[0].size() || startY >= image.size()) {
-        return RGB(0, 0, 0);
+// Setiap kandidat garis potong dievaluasi dalam O(1) dari summed-area table.
+// Jika error sama, dipilih posisi yang paling dekat dengan titik tengah
+bool QuadTree::chooseSplit(const Block& region, int& splitX, int& splitY) const {
+    int x = region.getX(), y = region.getY();
+    int width = region.getWidth(), height = region.getHeight();
+    bool binary = (partitionMode == ADAPTIVE_BINARY);
+    
+    // Dengan grid aktif, kandidat dibatasi pada garis grid jika ada di dalam region
+    bool gridX = snapToGrid(x, width, 0, splitGrid) != 0;
+    bool gridY = snapToGrid(y, height, 0, splitGrid) != 0;
+    
+    int bestX = -1;
+    double bestVertical = 0.0;
+    for (int offset = 1; offset < width; offset++) {
+        if (gridX && (x + offset) % splitGrid != 0) {
+            continue;
+        }
+        Block left(x, y, offset, height);
+        Block right(x + offset, y, width - offset, height);
+        if (binary && (left.getArea() < minBlockSize || right.getArea() < minBlockSize)) {
+            continue;
+        }
+        double cost = statistics->getSquaredDeviation(left) + statistics->getSquaredDeviation(right);
+        if (bestX < 0 || cost < bestVertical ||
+            (cost == bestVertical && abs(2 * offset - width) < abs(2 * bestX - width))) {
+            bestX = offset;
+            bestVertical = cost;
+        }
     }
     
-    long sumR = 0, sumG = 0, sumB = 0;
-    int count = 0;
-    
-    for (int y = startY; y < startY + height && y < image.size(); y++) {
-        for (int x = startX; x < startX + width && x < image[y].size(); x++) {
-            sumR += image[y][x].getRed();
-            sumG += image[y][x].getGreen();
-            sumB += image[y][x].getBlue();
-            count++;
+    int bestY = -1;
+    double bestHorizontal = 0.0;
+    for (int offset = 1; offset < height; offset++) {
+        if (gridY && (y + offset) % splitGrid != 0) {
+            continue;
+        }
+        Block top(x, y, width, offset);
+        Block bottom(x, y + offset, width, height - offset);
+        if (binary && (top.getArea() < minBlockSize || bottom.getArea() < minBlockSize)) {
+            continue;
+        }
+        double cost = statistics->getSquaredDeviation(top) + statistics->getSquaredDeviation(bottom);
+        if (bestY < 0 || cost < bestHorizontal ||
+            (cost == bestHorizontal && abs(2 * offset - height) < abs(2 * bestY - height))) {
+            bestY = offset;
+            bestHorizontal = cost;
         }
     }
     
-    if (count == 0) {
-        return RGB(0, 0, 0);
+    if (binary) {
+        if (bestX < 0 && bestY < 0) {
+            return false;
+        }
+        // Pilih garis dengan error anak terkecil; sisi lain tidak dipotong
+        if (bestY < 0 || (bestX >= 0 && bestVertical <= bestHorizontal)) {
+            splitX = bestX;
+            splitY = height;
+        } else {
+            splitX = width;
+            splitY = bestY;
+        }
+        return true;
     }
     
-    unsigned char avgR = static_cast<unsigned char>(sumR / count);
-    unsigned char avgG = static_cast<unsigned char>(sumG / count);
-    unsigned char avgB = static_cast<unsigned char>(sumB / count);
+    // Mode quad: kedua garis dipilih terpisah, lalu keempat anak harus memenuhi ukuran minimum
+    if (bestX >= 0 && bestY >= 0) {
+        long long smallest = static_cast<long long>(std::min(bestX, width - bestX)) * std::min(bestY, height - bestY);
+        if (smallest >= minBlockSize) {
+            splitX = bestX;
+            splitY = bestY;
+            return true;
+        }
+    }
     
-    return RGB(avgR, avgG, avgB);
+    // Kembali ke titik tengah jika potongan adaptif terlalu kecil
+    splitX = snapToGrid(x, width, width / 2, splitGrid);
+    splitY = snapToGrid(y, height, height / 2, splitGrid);
+    return std::min(splitX, width - splitX) * std::min(splitY, height - splitY) >= minBlockSize;
+}
+
+// Membuat node dengan warna rata-rata, leaf model di-fit jika bukan FLAT
+unique_ptr<Node> QuadTree::createNode(const Block& region) const {
+    unique_ptr<Node> node = make_unique<Node>(region, calculateAverageColor(region));
+    node->model = LeafModel::create(leafModel);
+    if (node->model) {
+        node->model->fit(*statistics, region);
+    }
+    return node;
+}
+
+// Menghitung warna rata-rata dari region
+RGB QuadTree::calculateAverageColor(const Block& region) const {
+    // Rata-rata dihitung dalam O(1) dari summed-area table
+    return statistics->getAverageColor(region);
 }
 
 // Menghitung error untuk region berdasarkan metode yang dipilih
 double QuadTree::calculateError(const Block& region, const RGB& avgColor) const {
     switch (errorMetric) {
         case VARIANCE:
-            return ErrorMetrics::calculateVariance(this->image, region, avgColor);
+            return ErrorMetrics::calculateVariance(*statistics, region, avgColor);
         case MEAN_ABSOLUTE_DEVIATION:
             return ErrorMetrics::calculateMAD(this->image, region, avgColor);
         case MAX_PIXEL_DIFFERENCE:
@@ -215,9 +373,25 @@ double QuadTree::calculateError(const Block& region, const RGB& avgColor) const
         case ENTROPY:
             return ErrorMetrics::calculateEntropy(this->image, region);
         case SSIM:
-            return ErrorMetrics::calculateSSIM(this->image, region, avgColor);
+            return ErrorMetrics::calculateSSIM(*statistics, region, avgColor);
+        default:
+            return ErrorMetrics::calculateVariance(*statistics, region, avgColor);
+    }
+}
+
+// Variance dan SSIM dihitung O(1) dari hasil fitting, metrik lain memindai residual
+double QuadTree::calculateError(const LeafModel& model) const {
+    switch (errorMetric) {
+        case MEAN_ABSOLUTE_DEVIATION:
+            return ErrorMetrics::calculateMAD(this->image, model);
+        case MAX_PIXEL_DIFFERENCE:
+            return ErrorMetrics::calculateMaxDifference(this->image, model);
+        case ENTROPY:
+            return ErrorMetrics::calculateEntropy(this->image, model);
+        case SSIM:
+            return ErrorMetrics::calculateSSIM(model);
         default:
-            return ErrorMetrics::calculateVariance(this->image, region, avgColor);
+            return ErrorMetrics::calculateVariance(model);
     }
 }
 
@@ -261,13 +435,25 @@ int QuadTree::countNodes(const Node* node) const {
     return count;
 }
 
+// Menghitung jumlah leaf node dalam pohon
+int QuadTree::countLeaves(const Node* node) const {
+    if (!node) {
+        return 0;
+    }
+    if (node->isLeaf) {
+        return 1;
+    }
+    return countLeaves(node->topLeft.get()) + countLeaves(node->topRight.get())
+         + countLeaves(node->bottomLeft.get()) + countLeaves(node->bottomRight.get());
+}
+
 // Membangun gambar hasil kompresi
 void QuadTree::buildCompressedImage(vector<vector<RGB>>& result, const Node* node) const {
     if (!node) {
         return;
     }
     
-    // Jika leaf node, isi region dengan warna rata-rata
+    // Jika leaf node, isi region dengan warna rata-rata atau prediksi leaf model
     if (node->isLeaf) {
         int startX = node->region.getX();
         int startY = node->region.getY();
@@ -276,7 +462,7 @@ void QuadTree::buildCompressedImage(vector<vector<RGB>>& result, const Node* nod
         
         for (int y = startY; y < startY + height && y < result.size(); y++) {
             for (int x = startX; x < startX + width && x < result[y].size(); x++) {
-                result[y][x] = node->avgColor;
+                result[y][x] = node->model ? node->model->predict(x, y) : node->avgColor;
             }
         }
     } else {
@@ -288,6 +474,207 @@ void QuadTree::buildCompressedImage(vector<vector<RGB>>& result, const Node* nod
     }
 }
 
-void QuadTree::setCompressionRegionCallback(const std::function<void(const Block&, const RGB&)>& cb) {
-    this->compressionRegionCallback = cb;
+// Mengisi buffer interleaved dari leaf node
+void QuadTree::rasterizeNode(unsigned char* buffer, int channels, const Node* node, int firstRow, int lastRow,
+                             const unordered_map<uint32_t, unsigned char>* paletteLookup) const {
+    if (!node) {
+        return;
+    }
+    
+    // Subtree yang seluruhnya di luar band tidak dikunjungi
+    int regionY = node->region.getY();
+    if (regionY >= lastRow || regionY + node->region.getHeight() <= firstRow) {
+        return;
+    }
+    
+    if (!node->isLeaf) {
+        rasterizeNode(buffer, channels, node->topLeft.get(), firstRow, lastRow, paletteLookup);
+        rasterizeNode(buffer, channels, node->topRight.get(), firstRow, lastRow, paletteLookup);
+        rasterizeNode(buffer, channels, node->bottomLeft.get(), firstRow, lastRow, paletteLookup);
+        rasterizeNode(buffer, channels, node->bottomRight.get(), firstRow, lastRow, paletteLookup);
+        return;
+    }
+    
+    int width = getWidth();
+    int startX = node->region.getX();
+    int startY = std::max(regionY, firstRow);
+    int endX = std::min(startX + node->region.getWidth(), width);
+    int endY = std::min({ regionY + node->region.getHeight(), lastRow, getHeight() });
+    if (startX >= endX || startY >= endY) {
+        return;
+    }
+    size_t rowStride = static_cast<size_t>(width) * channels;
+    size_t spanBytes = static_cast<size_t>(endX - startX) * channels;
+    unsigned char* first = buffer + (startY - firstRow) * rowStride + static_cast<size_t>(startX) * channels;
+    
+    auto writePixel = [channels, paletteLookup](unsigned char* pixel, const RGB& color) {
+        if (paletteLookup) {
+            auto entry = paletteLookup->find(packColor(color));
+            pixel[0] = entry != paletteLookup->end() ? entry->second : 0;
+            return;
+        }
+        pixel[0] = color.getRed();
+        if (channels >= 3) {
+            pixel[1] = color.getGreen();
+            pixel[2] = color.getBlue();
+        }
+        if (channels == 4) {
+            pixel[3] = 255;
+        }
+    };
+    
+    if (node->model) {
+        // Leaf model: prediksi per piksel
+        for (int y = startY; y < endY; y++) {
+            unsigned char* pixel = buffer + (y - firstRow) * rowStride + static_cast<size_t>(startX) * channels;
+            for (int x = startX; x < endX; x++, pixel += channels) {
+                writePixel(pixel, node->model->predict(x, y));
+            }
+        }
+        return;
+    }
+    
+    // Leaf flat: isi satu span baris, lalu salin span itu ke baris berikutnya
+    for (unsigned char* pixel = first; pixel < first + spanBytes; pixel += channels) {
+        writePixel(pixel, node->avgColor);
+    }
+    for (int y = startY + 1; y < endY; y++) {
+        std::memcpy(first + (y - startY) * rowStride, first, spanBytes);
+    }
+}
+
+// Leaf yang lebih kecil dari satu piksel tujuan terpetakan ke region kosong dan ditutup tetangganya
+void QuadTree::rasterizeScaledNode(unsigned char* buffer, int channels, const Node* node,
+                                   int targetWidth, int targetHeight) const {
+    if (!node) {
+        return;
+    }
+    if (!node->isLeaf) {
+        rasterizeScaledNode(buffer, channels, node->topLeft.get(), targetWidth, targetHeight);
+        rasterizeScaledNode(buffer, channels, node->topRight.get(), targetWidth, targetHeight);
+        rasterizeScaledNode(buffer, channels, node->bottomLeft.get(), targetWidth, targetHeight);
+        rasterizeScaledNode(buffer, channels, node->bottomRight.get(), targetWidth, targetHeight);
+        return;
+    }
+
+    int width = getWidth(), height = getHeight();
+    Block target = node->region.scaled(width, height, targetWidth, targetHeight);
+    if (target.getArea() <= 0) {
+        return;
+    }
+    size_t rowStride = static_cast<size_t>(targetWidth) * channels;
+    auto writePixel = [channels](unsigned char* pixel, const RGB& color) {
+        pixel[0] = color.getRed();
+        if (channels >= 3) {
+            pixel[1] = color.getGreen();
+            pixel[2] = color.getBlue();
+        }
+        if (channels == 4) {
+            pixel[3] = 255;
+        }
+    };
+
+    int regionX = node->region.getX(), regionY = node->region.getY();
+    int lastX = regionX + node->region.getWidth() - 1, lastY = regionY + node->region.getHeight() - 1;
+    for (int y = target.getY(); y < target.getY() + target.getHeight(); y++) {
+        unsigned char* pixel = buffer + y * rowStride + static_cast<size_t>(target.getX()) * channels;
+        if (!node->model) {
+            if (y == target.getY()) {
+                for (int x = 0; x < target.getWidth(); x++, pixel += channels) {
+                    writePixel(pixel, node->avgColor);
+                }
+            } else {
+                std::memcpy(pixel, pixel - (y - target.getY()) * rowStride, static_cast<size_t>(target.getWidth()) * channels);
+            }
+            continue;
+        }
+        // Leaf model dievaluasi di titik tengah piksel tujuan, dijepit ke dalam region leaf
+        int sourceY = static_cast<int>((2LL * y + 1) * height / (2LL * targetHeight));
+        sourceY = std::max(regionY, std::min(lastY, sourceY));
+        for (int x = target.getX(); x < target.getX() + target.getWidth(); x++, pixel += channels) {
+            int sourceX = static_cast<int>((2LL * x + 1) * width / (2LL * targetWidth));
+            sourceX = std::max(regionX, std::min(lastX, sourceX));
+            writePixel(pixel, node->model->predict(sourceX, sourceY));
+        }
+    }
+}
+
+// Warna leaf datar dikumpulkan sampai batas palet terlampaui
+bool QuadTree::collectLeafColors(const Node* node, vector<RGB>& palette,
+                                 unordered_map<uint32_t, unsigned char>& lookup, size_t maxColors) const {
+    if (!node) {
+        return true;
+    }
+    if (!node->isLeaf) {
+        return collectLeafColors(node->topLeft.get(), palette, lookup, maxColors)
+            && collectLeafColors(node->topRight.get(), palette, lookup, maxColors)
+            && collectLeafColors(node->bottomLeft.get(), palette, lookup, maxColors)
+            && collectLeafColors(node->bottomRight.get(), palette, lookup, maxColors);
+    }
+    if (node->model) {
+        return false;
+    }
+    uint32_t key = packColor(node->avgColor);
+    if (lookup.count(key)) {
+        return true;
+    }
+    if (palette.size() >= maxColors) {
+        return false;
+    }
+    lookup[key] = static_cast<unsigned char>(palette.size());
+    palette.push_back(node->avgColor);
+    return true;
+}
+
+void QuadTree::setRecordSplits(bool record) {
+    recordSplits = record;
+}
+
+const vector<QuadTree::SplitEvent>& QuadTree::getSplitLog() const {
+    return splitLog;
+}
+
+
+void QuadTree::setImportanceMap(shared_ptr<const ImportanceMap> map) {
+    this->importanceMap = map;
+}
+
+void QuadTree::setLeafModel(LeafModel::Type type) {
+    this->leafModel = type;
+}
+
+LeafModel::Type QuadTree::getLeafModel() const {
+    return leafModel;
+}
+
+void QuadTree::setPartitionMode(PartitionMode mode) {
+    this->partitionMode = mode;
+}
+
+QuadTree::PartitionMode QuadTree::getPartitionMode() const {
+    return partitionMode;
+}
+
+void QuadTree::setSplitGrid(int grid) {
+    this->splitGrid = std::max(0, grid);
+}
+
+int QuadTree::getSplitGrid() const {
+    return splitGrid;
+}
+
+// Block yang lebih kecil dari grid tetap dipotong di posisi semula
+int QuadTree::snapToGrid(int origin, int length, int offset, int grid) {
+    if (grid <= 0 || length < grid) {
+        return offset;
+    }
+    int position = origin + offset;
+    int lower = (position / grid) * grid;
+    int upper = lower + grid;
+    bool lowerInside = lower > origin && lower < origin + length;
+    bool upperInside = upper > origin && upper < origin + length;
+    if (lowerInside && (!upperInside || position - lower <= upper - position)) {
+        return lower - origin;
+    }
+    return upperInside ? upper - origin : offset;
 }
@@ -1,12 +1,16 @@
 #ifndef __QUADTREE__HPP__
 #define __QUADTREE__HPP__
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <functional>
+#include <unordered_map>
 #include "Node.hpp"
 #include "RGB.hpp"
 #include "Block.hpp"
+#include "ImageStatistics.hpp"
+#include "ImportanceMap.hpp"
 
 using namespace std;
 
@@ -24,20 +28,43 @@ public:
         ENTROPY,                
         SSIM                    
     };
+
+    enum PartitionMode {
+        QUADRANT,           // Selalu dibagi empat di titik tengah (bawaan)
+        ADAPTIVE_BINARY,    // Dibagi dua pada garis vertikal/horizontal dengan error anak terkecil
+        ADAPTIVE_QUAD       // Dibagi empat pada garis vertikal dan horizontal terbaik
+    };
     
     // Tipe untuk callback visualisasi proses kompresi
     using CompressionCallback = function<void(const vector<vector<RGB>>&)>;
+
+    // Satu entri log split: region yang dibagi, kedalamannya, posisi potongan, dan warna rata-rata tiap anak
+    struct SplitEvent {
+        Block region;
+        int depth;
+        int splitX, splitY;
+        RGB childColors[4];
+    };
     
 private:
     unique_ptr<Node> root;       // Root node dari QuadTree
-    vector<vector<RGB>> image;   // Gambar original
+    shared_ptr<const ImageStatistics> statistics; // Statistik gambar (dapat dipakai bersama)
+    const vector<vector<RGB>>& image; // Gambar original (milik statistics)
     int minBlockSize;            // Ukuran blok minimum untuk subdivisi
     double threshold;            // Threshold error untuk subdivisi
     ErrorMetricType errorMetric; // Metrik error yang digunakan
     int nodeCount;               // Jumlah node dalam tree
+    int leafCount;               // Jumlah leaf node dalam tree
     int maxDepth;                // Kedalaman maksimum tree
+    int nodeProcessedCount;      // Jumlah subdivisi selama buildTree
+    shared_ptr<const ImportanceMap> importanceMap; // Skala threshold per region (opsional)
+    LeafModel::Type leafModel;   // Prediktor warna untuk leaf node
+    PartitionMode partitionMode; // Cara menentukan posisi potongan
+    int splitGrid;               // Grid posisi potongan dalam piksel, misal MCU JPEG (0 = nonaktif)
     
     CompressionCallback compressionCallback;
+    bool recordSplits;           // Catat setiap split ke splitLog selama buildTree
+    vector<SplitEvent> splitLog; // Urutan split untuk replay visualisasi
     
 public:
     /**
@@ -48,6 +75,15 @@ public:
      * @param Metrik error yang digunakan
      */
     QuadTree(const vector<vector<RGB>>&, int, double, ErrorMetricType);
+
+    /**
+     * @brief Constructor dengan statistik gambar yang sudah dihitung sebelumnya
+     * @param Statistik gambar yang dipakai bersama
+     * @param Ukuran blok minimum
+     * @param Threshold error
+     * @param Metrik error yang digunakan
+     */
+    QuadTree(shared_ptr<const ImageStatistics>, int, double, ErrorMetricType);
     
     /**
      * @brief Membangun QuadTree dengan pendekatan divide and conquer
@@ -59,12 +95,67 @@ public:
      * @return Gambar hasil kompresi
      */
     vector<vector<RGB>> getCompressedImage() const;
+
+    /**
+     * @brief Merasterisasi leaf langsung ke buffer piksel interleaved milik pemanggil
+     * @param Buffer berukuran width * height * channel, baris berurutan tanpa padding
+     * @param Jumlah channel per piksel (1 = hanya merah, 3 = RGB, 4 = RGBA dengan alpha 255)
+     */
+    void rasterize(unsigned char*, int) const;
+
+    /**
+     * @brief Merasterisasi hanya baris [awal, akhir) ke buffer band; leaf di luar band dilewati
+     * @param Buffer berukuran width * (akhir - awal) * channel, baris pertama = baris awal
+     * @param Jumlah channel per piksel (1 = hanya merah, 3 = RGB, 4 = RGBA dengan alpha 255)
+     * @param Baris awal (inklusif)
+     * @param Baris akhir (eksklusif)
+     */
+    void rasterizeRows(unsigned char*, int, int, int) const;
+
+    /**
+     * @brief Merasterisasi tree pada resolusi lain: setiap leaf dipetakan ke koordinat terskala,
+     *        leaf model dievaluasi di titik tengah piksel terskala (tanpa render ukuran penuh)
+     * @param Buffer berukuran lebar * tinggi tujuan * channel
+     * @param Jumlah channel per piksel (1 = hanya merah, 3 = RGB, 4 = RGBA dengan alpha 255)
+     * @param Lebar tujuan
+     * @param Tinggi tujuan
+     */
+    void rasterizeScaled(unsigned char*, int, int, int) const;
+
+    /**
+     * @brief Mengumpulkan warna unik leaf node langsung dari tree, tanpa membaca raster
+     * @param Output palet warna (urutan kemunculan)
+     * @param Jumlah warna maksimum
+     * @return true jika semua leaf datar (tanpa leaf model) dan jumlah warna tidak melebihi batas
+     */
+    bool getLeafPalette(vector<RGB>&, size_t) const;
+
+    /**
+     * @brief Merasterisasi index palet setiap leaf ke buffer satu byte per piksel
+     * @param Buffer berukuran width * height
+     * @param Palet dari getLeafPalette
+     */
+    void rasterizeIndices(unsigned char*, const vector<RGB>&) const;
     
     /**
      * @brief Mendapatkan jumlah node dalam tree
      * @return Jumlah node
      */
     int getNodeCount() const;
+
+    /**
+     * @brief Mendapatkan root node (nullptr jika tree belum dibangun)
+     */
+    const Node* getRoot() const;
+
+    int getWidth() const;
+    int getHeight() const;
+
+    /**
+     * @brief Mendapatkan jumlah leaf node dalam tree
+     * @return Jumlah leaf node
+     */
+    int getLeafCount() const;
     
     /**
      * @brief Mendapatkan kedalaman maksimum tree
@@ -77,6 +168,13 @@ public:
      * @return Persentase kompresi (0.0-1.0)
      */
     double getCompressionPercentage() const;
+
+    /**
+     * @brief Memperkirakan ukuran data terkompresi (setiap node = 16 byte posisi & ukuran + 3 byte warna,
+     *        leaf memakai parameter leaf model)
+     * @return Perkiraan ukuran dalam bytes
+     */
+    size_t getEstimatedCompressedSize() const;
     
     /**
      * @brief Menetapkan callback untuk visualisasi proses kompresi
@@ -90,8 +188,57 @@ public:
      */
     vector<vector<RGB>> getCurrentStateImage() const;
 
-    void setCompressionRegionCallback(const std::function<void(const Block&, const RGB&)>& cb);
+    /**
+     * @brief Mengaktifkan pencatatan log split selama buildTree (untuk replay GIF tanpa membangun ulang tree)
+     * @param true untuk mencatat
+     */
+    void setRecordSplits(bool);
+
+    /**
+     * @brief Log split dalam urutan terjadinya; kosong jika pencatatan tidak aktif
+     */
+    const vector<SplitEvent>& getSplitLog() const;
+
+    /**
+     * @brief Menetapkan peta kepentingan untuk threshold per region
+     * @param Peta kepentingan (nullptr untuk threshold seragam)
+     */
+    void setImportanceMap(shared_ptr<const ImportanceMap>);
+
+    /**
+     * @brief Menetapkan jenis prediktor warna leaf node
+     * @param Tipe leaf model (FLAT = warna rata-rata)
+     */
+    void setLeafModel(LeafModel::Type);
+
+    LeafModel::Type getLeafModel() const;
 
+    /**
+     * @brief Menetapkan cara pembagian node
+     * @param Mode partisi (QUADRANT = titik tengah)
+     */
+    void setPartitionMode(PartitionMode);
+
+    PartitionMode getPartitionMode() const;
+
+    /**
+     * @brief Menyelaraskan posisi potongan ke grid absolut (misal 8 atau 16 piksel MCU JPEG)
+     *        pada block yang paling sedikit sebesar grid
+     * @param Ukuran grid dalam piksel (0 = nonaktif)
+     */
+    void setSplitGrid(int);
+
+    int getSplitGrid() const;
+
+    /**
+     * @brief Offset garis grid terdekat ke offset yang diminta, di dalam sebuah rentang
+     * @param Koordinat awal rentang
+     * @param Panjang rentang
+     * @param Offset yang diminta
+     * @param Ukuran grid (0 = nonaktif)
+     * @return Offset garis grid (0 < offset < panjang), atau offset semula jika tidak ada
+     */
+    static int snapToGrid(int, int, int, int);
     
 private:
     /**
@@ -101,6 +248,22 @@ private:
      */
     void subdivide(Node*, int);
     
+    /**
+     * @brief Memilih posisi potongan adaptif yang meminimalkan jumlah error kuadrat anak
+     * @param Region yang akan dibagi
+     * @param Output offset potongan vertikal
+     * @param Output offset potongan horizontal
+     * @return true jika ada potongan yang memenuhi ukuran blok minimum
+     */
+    bool chooseSplit(const Block&, int&, int&) const;
+
+    /**
+     * @brief Membuat node baru beserta warna rata-rata dan leaf model-nya
+     * @param Region node
+     * @return Node baru
+     */
+    unique_ptr<Node> createNode(const Block&) const;
+
     /**
      * @brief Menghitung warna rata-rata dari region
      * @param Region yang akan dihitung warna rata-ratanya
@@ -116,6 +279,13 @@ private:
      */
     double calculateError(const Block&, const RGB&) const;
 
+    /**
+     * @brief Menghitung error residual leaf model berdasarkan metode yang dipilih
+     * @param Leaf model yang sudah di-fit
+     * @return Nilai error
+     */
+    double calculateError(const LeafModel&) const;
+
     /**
      * @brief Menghitung kedalaman maksimum dari pohon
      * @param Node saat ini
@@ -131,6 +301,13 @@ private:
      * @return Jumlah node
      */
     int countNodes(const Node*) const;
+
+    /**
+     * @brief Menghitung jumlah leaf node dalam pohon
+     * @param Node saat ini
+     * @return Jumlah leaf node
+     */
+    int countLeaves(const Node*) const;
     
     /**
      * @brief Membangun gambar hasil kompresi
@@ -138,8 +315,38 @@ private:
      * @param Node saat ini
      */
     void buildCompressedImage(vector<vector<RGB>>&, const Node*) const;
-    std::function<void(const Block&, const RGB&)> compressionRegionCallback;
 
+    /**
+     * @brief Mengisi region leaf ke buffer interleaved; leaf flat diisi per span baris
+     * @param Buffer piksel
+     * @param Jumlah channel per piksel
+     * @param Node saat ini
+     * @param Baris awal band yang dipetakan ke baris pertama buffer
+     * @param Baris akhir band (eksklusif)
+     * @param Lookup warna ke index palet (nullptr untuk menulis warna; jika diisi, channel = 1)
+     */
+    void rasterizeNode(unsigned char*, int, const Node*, int, int,
+                       const unordered_map<uint32_t, unsigned char>* = nullptr) const;
+
+    /**
+     * @brief Mengisi region terskala setiap leaf di bawah node ke buffer berukuran tujuan
+     * @param Buffer piksel
+     * @param Jumlah channel per piksel
+     * @param Node saat ini
+     * @param Lebar tujuan
+     * @param Tinggi tujuan
+     */
+    void rasterizeScaledNode(unsigned char*, int, const Node*, int, int) const;
+
+    /**
+     * @brief Menambahkan warna leaf di bawah node ke palet
+     * @param Node saat ini
+     * @param Palet
+     * @param Lookup warna yang sudah ada di palet
+     * @param Jumlah warna maksimum
+     * @return false jika ada leaf model atau warna melebihi batas
+     */
+    bool collectLeafColors(const Node*, vector<RGB>&, unordered_map<uint32_t, unsigned char>&, size_t) const;
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "RangeCoder.hpp"
+
+const uint16_t RangeEncoder::PROBABILITY_INIT;
+
+namespace {
+    const uint32_t TOP_VALUE = 1u << 24;
+    const int MOVE_BITS = 5;
+}
+
+BitTreeModel::BitTreeModel(int _numBits)
+    : numBits(_numBits), probabilities(static_cast<size_t>(1) << _numBits, RangeEncoder::PROBABILITY_INIT) {
+}
+
+// ==================== RangeEncoder ====================
+
+RangeEncoder::RangeEncoder()
+    : low(0), range(0xFFFFFFFFu), cache(0), cacheSize(1) {
+}
+
+void RangeEncoder::encodeBit(uint16_t& probability, int bit) {
+    uint32_t bound = (range >> PROBABILITY_BITS) * probability;
+    if (bit == 0) {
+        range = bound;
+        probability += ((1 << PROBABILITY_BITS) - probability) >> MOVE_BITS;
+    } else {
+        low += bound;
+        range -= bound;
+        probability -= probability >> MOVE_BITS;
+    }
+    while (range < TOP_VALUE) {
+        range <<= 8;
+        shiftLow();
+    }
+}
+
+void RangeEncoder::encodeDirectBits(uint32_t value, int numBits) {
+    for (int i = numBits - 1; i >= 0; i--) {
+        range >>= 1;
+        if ((value >> i) & 1) {
+            low += range;
+        }
+        while (range < TOP_VALUE) {
+            range <<= 8;
+            shiftLow();
+        }
+    }
+}
+
+void RangeEncoder::encodeSymbol(BitTreeModel& model, uint32_t symbol) {
+    uint32_t index = 1;
+    for (int i = model.numBits - 1; i >= 0; i--) {
+        int bit = (symbol >> i) & 1;
+        encodeBit(model.probabilities[index], bit);
+        index = (index << 1) | bit;
+    }
+}
+
+void RangeEncoder::flush() {
+    for (int i = 0; i < 5; i++) {
+        shiftLow();
+    }
+}
+
+const vector<unsigned char>& RangeEncoder::getOutput() const {
+    return output;
+}
+
+size_t RangeEncoder::getSize() const {
+    return output.size() + cacheSize + 4;
+}
+
+// Carry dari low ditunda lewat cache sampai byte berikutnya pasti
+void RangeEncoder::shiftLow() {
+    if (static_cast<uint32_t>(low) < 0xFF000000u || (low >> 32) != 0) {
+        uint8_t carry = static_cast<uint8_t>(low >> 32);
+        uint8_t temp = cache;
+        do {
+            output.push_back(static_cast<unsigned char>(temp + carry));
+            temp = 0xFF;
+        } while (--cacheSize != 0);
+        cache = static_cast<uint8_t>(low >> 24);
+    }
+    cacheSize++;
+    low = (low & 0x00FFFFFFu) << 8;
+}
+
+// ==================== RangeDecoder ====================
+
+RangeDecoder::RangeDecoder(const unsigned char* _data, size_t _size)
+    : data(_data), size(_size), position(0), range(0xFFFFFFFFu), code(0) {
+    for (int i = 0; i < 5; i++) {
+        code = (code << 8) | nextByte();
+    }
+}
+
+int RangeDecoder::decodeBit(uint16_t& probability) {
+    uint32_t bound = (range >> RangeEncoder::PROBABILITY_BITS) * probability;
+    int bit;
+    if (code < bound) {
+        range = bound;
+        probability += ((1 << RangeEncoder::PROBABILITY_BITS) - probability) >> MOVE_BITS;
+        bit = 0;
+    } else {
+        code -= bound;
+        range -= bound;
+        probability -= probability >> MOVE_BITS;
+        bit = 1;
+    }
+    while (range < TOP_VALUE) {
+        range <<= 8;
+        code = (code << 8) | nextByte();
+    }
+    return bit;
+}
+
+uint32_t RangeDecoder::decodeDirectBits(int numBits) {
+    uint32_t result = 0;
+    for (int i = 0; i < numBits; i++) {
+        range >>= 1;
+        int bit = 0;
+        if (code >= range) {
+            code -= range;
+            bit = 1;
+        }
+        result = (result << 1) | bit;
+        while (range < TOP_VALUE) {
+            range <<= 8;
+            code = (code << 8) | nextByte();
+        }
+    }
+    return result;
+}
+
+uint32_t RangeDecoder::decodeSymbol(BitTreeModel& model) {
+    uint32_t index = 1;
+    for (int i = 0; i < model.numBits; i++) {
+        index = (index << 1) | decodeBit(model.probabilities[index]);
+    }
+    return index - (1u << model.numBits);
+}
+
+bool RangeDecoder::isExhausted() const {
+    return position > size;
+}
+
+unsigned char RangeDecoder::nextByte() {
+    if (position < size) {
+        return data[position++];
+    }
+    position++;
+    return 0;
+}
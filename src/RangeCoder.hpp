@@ -0,0 +1,117 @@
+#ifndef __RANGE_CODER__HPP__
+#define __RANGE_CODER__HPP__
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class BitTreeModel
+ * @brief Model probabilitas adaptif untuk simbol beberapa bit (pohon biner bit demi bit)
+ */
+class BitTreeModel {
+private:
+    int numBits;
+    vector<uint16_t> probabilities;
+
+    friend class RangeEncoder;
+    friend class RangeDecoder;
+
+public:
+    /**
+     * @brief Constructor untuk BitTreeModel
+     * @param Jumlah bit simbol (maksimal 16)
+     */
+    BitTreeModel(int = 8);
+};
+
+/**
+ * @class RangeEncoder
+ * @brief Range coder biner adaptif (gaya LZMA) yang menulis ke buffer byte
+ */
+class RangeEncoder {
+private:
+    uint64_t low;
+    uint32_t range;
+    uint8_t cache;
+    uint64_t cacheSize;
+    vector<unsigned char> output;
+
+public:
+    static const int PROBABILITY_BITS = 11;
+    static const uint16_t PROBABILITY_INIT = 1 << (PROBABILITY_BITS - 1);
+
+    RangeEncoder();
+
+    /**
+     * @brief Mengodekan satu bit dengan probabilitas adaptif
+     * @param Probabilitas bit 0 (diperbarui setelah pengodean)
+     * @param Nilai bit
+     */
+    void encodeBit(uint16_t&, int);
+
+    /**
+     * @brief Mengodekan bit dengan probabilitas tetap 1/2
+     * @param Nilai
+     * @param Jumlah bit (dari MSB)
+     */
+    void encodeDirectBits(uint32_t, int);
+
+    /**
+     * @brief Mengodekan simbol dengan model pohon bit
+     * @param Model simbol
+     * @param Nilai simbol
+     */
+    void encodeSymbol(BitTreeModel&, uint32_t);
+
+    /**
+     * @brief Menulis sisa state ke buffer, wajib dipanggil sebelum getOutput
+     */
+    void flush();
+
+    const vector<unsigned char>& getOutput() const;
+
+    /**
+     * @brief Perkiraan jumlah byte yang sudah dihasilkan (termasuk byte tertunda)
+     */
+    size_t getSize() const;
+
+private:
+    void shiftLow();
+};
+
+/**
+ * @class RangeDecoder
+ * @brief Pasangan RangeEncoder; membaca di luar buffer menghasilkan byte nol
+ */
+class RangeDecoder {
+private:
+    const unsigned char* data;
+    size_t size;
+    size_t position;
+    uint32_t range;
+    uint32_t code;
+
+public:
+    /**
+     * @brief Constructor untuk RangeDecoder
+     * @param Buffer data terkode
+     * @param Ukuran buffer
+     */
+    RangeDecoder(const unsigned char*, size_t);
+
+    int decodeBit(uint16_t&);
+    uint32_t decodeDirectBits(int);
+    uint32_t decodeSymbol(BitTreeModel&);
+
+    /**
+     * @brief Apakah decoder sudah membaca melewati akhir buffer
+     */
+    bool isExhausted() const;
+
+private:
+    unsigned char nextByte();
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "SvgWriter.hpp"
+#include "Deflate.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+string SvgWriter::toSvg(const QuadTree& tree, size_t* rectCount) {
+    vector<Rect> rects;
+    collectLeaves(tree.getRoot(), rects);
+    mergeRuns(rects);
+
+    string width = std::to_string(tree.getWidth());
+    string height = std::to_string(tree.getHeight());
+    string svg;
+    svg.reserve(64 + rects.size() * 48);
+    svg += "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" + width + "\" height=\"" + height
+         + "\" viewBox=\"0 0 " + width + " " + height + "\" shape-rendering=\"crispEdges\">\n";
+    for (const Rect& rect : rects) {
+        svg += "<rect x=\"";
+        svg += std::to_string(rect.x);
+        svg += "\" y=\"";
+        svg += std::to_string(rect.y);
+        svg += "\" width=\"";
+        svg += std::to_string(rect.width);
+        svg += "\" height=\"";
+        svg += std::to_string(rect.height);
+        svg += "\" fill=\"";
+        appendColor(svg, rect.color);
+        svg += "\"/>\n";
+    }
+    svg += "</svg>\n";
+
+    if (rectCount) {
+        *rectCount = rects.size();
+    }
+    return svg;
+}
+
+bool SvgWriter::write(const QuadTree& tree, const string& path, bool compress) {
+    if (!tree.getRoot()) {
+        std::cerr << "Error: QuadTree must be built before writing SVG" << std::endl;
+        return false;
+    }
+    if (tree.getLeafModel() != LeafModel::FLAT) {
+        std::cerr << "Warning: SVG output draws leaf model blocks with their average color" << std::endl;
+    }
+
+    string svg = toSvg(tree);
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open " << path << " for writing" << std::endl;
+        return false;
+    }
+    if (compress) {
+        vector<unsigned char> compressed;
+        Deflate::gzip(reinterpret_cast<const unsigned char*>(svg.data()), svg.size(), compressed);
+        file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+    } else {
+        file.write(svg.data(), svg.size());
+    }
+    return static_cast<bool>(file);
+}
+
+void SvgWriter::collectLeaves(const Node* node, vector<Rect>& rects) {
+    if (!node) {
+        return;
+    }
+    if (!node->getIsLeaf()) {
+        for (int quadrant = 0; quadrant < 4; quadrant++) {
+            collectLeaves(node->getChild(quadrant), rects);
+        }
+        return;
+    }
+    const Block& region = node->getRegion();
+    const RGB& color = node->getAvgColor();
+    rects.push_back({ region.getX(), region.getY(), region.getWidth(), region.getHeight(),
+                      (static_cast<uint32_t>(color.getRed()) << 16) | (static_cast<uint32_t>(color.getGreen()) << 8)
+                      | color.getBlue() });
+}
+
+// Diurutkan per (y, tinggi, x) sehingga leaf yang dapat digabung berurutan
+void SvgWriter::mergeRuns(vector<Rect>& rects) {
+    std::sort(rects.begin(), rects.end(), [](const Rect& a, const Rect& b) {
+        if (a.y != b.y) return a.y < b.y;
+        if (a.height != b.height) return a.height < b.height;
+        return a.x < b.x;
+    });
+
+    size_t count = 0;
+    for (size_t i = 0; i < rects.size(); i++) {
+        if (count > 0) {
+            Rect& last = rects[count - 1];
+            const Rect& rect = rects[i];
+            if (last.y == rect.y && last.height == rect.height && last.color == rect.color &&
+                last.x + last.width == rect.x) {
+                last.width += rect.width;
+                continue;
+            }
+        }
+        rects[count++] = rects[i];
+    }
+    rects.resize(count);
+}
+
+void SvgWriter::appendColor(string& out, uint32_t color) {
+    const char* digits = "0123456789abcdef";
+    int nibbles[6];
+    for (int i = 0; i < 6; i++) {
+        nibbles[i] = (color >> (20 - 4 * i)) & 0xF;
+    }
+    out += '#';
+    if (nibbles[0] == nibbles[1] && nibbles[2] == nibbles[3] && nibbles[4] == nibbles[5]) {
+        out += digits[nibbles[0]];
+        out += digits[nibbles[2]];
+        out += digits[nibbles[4]];
+        return;
+    }
+    for (int i = 0; i < 6; i++) {
+        out += digits[nibbles[i]];
+    }
+}
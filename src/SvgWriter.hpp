@@ -0,0 +1,55 @@
+#ifndef __SVG_WRITER__HPP__
+#define __SVG_WRITER__HPP__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "QuadTree.hpp"
+
+using namespace std;
+
+/**
+ * @class SvgWriter
+ * @brief Output vektor langsung dari himpunan leaf: satu <rect> per leaf, dengan leaf bersebelahan
+ *        horizontal yang tinggi dan warnanya sama digabung menjadi satu. Tidak ada rasterisasi.
+ *        Leaf dengan leaf model digambar dengan warna rata-ratanya
+ */
+class SvgWriter {
+public:
+    /**
+     * @brief Membuat dokumen SVG dari QuadTree yang sudah dibangun
+     * @param QuadTree sumber
+     * @param Output jumlah <rect> yang ditulis (opsional)
+     * @return Dokumen SVG
+     */
+    static string toSvg(const QuadTree&, size_t* = nullptr);
+
+    /**
+     * @brief Menulis QuadTree sebagai file SVG
+     * @param QuadTree sumber
+     * @param Path file output
+     * @param true untuk kompresi gzip (.svgz)
+     * @return true jika berhasil
+     */
+    static bool write(const QuadTree&, const string&, bool);
+
+private:
+    struct Rect {
+        int x, y, width, height;
+        uint32_t color;     // 0xRRGGBB
+    };
+
+    static void collectLeaves(const Node*, vector<Rect>&);
+
+    /**
+     * @brief Menggabungkan leaf yang bersebelahan pada baris yang sama dengan tinggi dan warna sama
+     */
+    static void mergeRuns(vector<Rect>&);
+
+    /**
+     * @brief Menambahkan warna hex, bentuk pendek #rgb jika memungkinkan
+     */
+    static void appendColor(string&, uint32_t);
+};
+
+#endif
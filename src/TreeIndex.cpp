@@ -0,0 +1,283 @@
+#include "TreeIndex.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#undef RGB
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(TreeIndex::Header) == 32, "TreeIndex::Header must be 32 bytes");
+static_assert(sizeof(TreeIndex::IndexNode) == 32, "TreeIndex::IndexNode must be 32 bytes");
+
+namespace {
+    const char MAGIC[4] = { 'Q', 'T', 'I', '1' };
+}
+
+TreeIndex::TreeIndex()
+    : data(nullptr), size(0), header(nullptr), nodes(nullptr),
+#ifdef _WIN32
+      fileHandle(nullptr), mappingHandle(nullptr) {
+#else
+      fileDescriptor(-1) {
+#endif
+}
+
+TreeIndex::~TreeIndex() {
+    close();
+}
+
+// Node ditulis breadth-first agar anak-anak sebuah node selalu bersebelahan
+bool TreeIndex::write(const QuadTree& tree, const string& path) {
+    const Node* root = tree.getRoot();
+    if (!root) {
+        std::cerr << "Error: QuadTree must be built before writing an index" << std::endl;
+        return false;
+    }
+    if (tree.getWidth() > 65535 || tree.getHeight() > 65535) {
+        std::cerr << "Error: Tree index supports images up to 65535x65535" << std::endl;
+        return false;
+    }
+
+    vector<const Node*> order(1, root);
+    vector<IndexNode> records;
+    records.reserve(tree.getNodeCount());
+
+    for (size_t i = 0; i < order.size(); i++) {
+        const Node* node = order[i];
+        IndexNode record;
+        std::memset(&record, 0, sizeof(record));
+
+        const Block& region = node->getRegion();
+        record.x = static_cast<uint16_t>(region.getX());
+        record.y = static_cast<uint16_t>(region.getY());
+        record.width = static_cast<uint16_t>(region.getWidth());
+        record.height = static_cast<uint16_t>(region.getHeight());
+        record.red = node->getAvgColor().getRed();
+        record.green = node->getAvgColor().getGreen();
+        record.blue = node->getAvgColor().getBlue();
+        record.isLeaf = node->getIsLeaf() ? 1 : 0;
+
+        if (node->getIsLeaf()) {
+            const LeafModel* model = node->getModel();
+            for (int c = 0; model && c < model->getCornerCount(); c++) {
+                record.corners[c * 3] = model->getCorner(c).getRed();
+                record.corners[c * 3 + 1] = model->getCorner(c).getGreen();
+                record.corners[c * 3 + 2] = model->getCorner(c).getBlue();
+            }
+        } else {
+            record.firstChild = static_cast<uint32_t>(order.size());
+            for (int quadrant = 0; quadrant < 4; quadrant++) {
+                if (node->getChild(quadrant)) {
+                    order.push_back(node->getChild(quadrant));
+                    record.childCount++;
+                }
+            }
+        }
+        records.push_back(record);
+    }
+
+    Header fileHeader;
+    std::memset(&fileHeader, 0, sizeof(fileHeader));
+    std::memcpy(fileHeader.magic, MAGIC, 4);
+    fileHeader.width = tree.getWidth();
+    fileHeader.height = tree.getHeight();
+    fileHeader.nodeCount = static_cast<uint32_t>(records.size());
+    fileHeader.leafModel = tree.getLeafModel();
+    fileHeader.partition = tree.getPartitionMode();
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Cannot open " << path << " for writing" << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+    file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(IndexNode));
+    return static_cast<bool>(file);
+}
+
+bool TreeIndex::open(const string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Error: Cannot open " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        std::cerr << "Error: Cannot map empty file " << path << std::endl;
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        std::cerr << "Error: Cannot map " << path << std::endl;
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        std::cerr << "Error: Cannot open " << path << std::endl;
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(descriptor, &fileStat) != 0 || fileStat.st_size == 0) {
+        ::close(descriptor);
+        std::cerr << "Error: Cannot map empty file " << path << std::endl;
+        return false;
+    }
+    void* view = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+    if (view == MAP_FAILED) {
+        ::close(descriptor);
+        std::cerr << "Error: Cannot map " << path << std::endl;
+        return false;
+    }
+    fileDescriptor = descriptor;
+    data = static_cast<const unsigned char*>(view);
+    size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    // Validasi header dan ukuran, lalu node di-query langsung dari halaman yang di-map
+    header = reinterpret_cast<const Header*>(data);
+    if (size < sizeof(Header) || std::memcmp(header->magic, MAGIC, 4) != 0 ||
+        header->width == 0 || header->height == 0 || header->width > 65535 || header->height > 65535 ||
+        header->nodeCount == 0 || header->leafModel > static_cast<uint32_t>(LeafModel::BILINEAR) ||
+        size < sizeof(Header) + static_cast<size_t>(header->nodeCount) * sizeof(IndexNode)) {
+        std::cerr << "Error: Invalid tree index file " << path << std::endl;
+        close();
+        return false;
+    }
+    nodes = reinterpret_cast<const IndexNode*>(data + sizeof(Header));
+    return true;
+}
+
+void TreeIndex::close() {
+    if (!data) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    fileHandle = mappingHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(data), size);
+    ::close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    data = nullptr;
+    header = nullptr;
+    nodes = nullptr;
+    size = 0;
+}
+
+bool TreeIndex::isOpen() const {
+    return data != nullptr;
+}
+
+int TreeIndex::getWidth() const {
+    return header ? header->width : 0;
+}
+
+int TreeIndex::getHeight() const {
+    return header ? header->height : 0;
+}
+
+int TreeIndex::getNodeCount() const {
+    return header ? header->nodeCount : 0;
+}
+
+const TreeIndex::IndexNode& TreeIndex::getNode(int index) const {
+    return nodes[index];
+}
+
+int TreeIndex::findLeaf(int x, int y) const {
+    if (!header || x < 0 || y < 0 || x >= getWidth() || y >= getHeight()) {
+        return -1;
+    }
+
+    uint32_t index = 0;
+    while (!nodes[index].isLeaf) {
+        const IndexNode& node = nodes[index];
+        uint32_t next = index;
+        for (uint32_t i = 0; i < node.childCount; i++) {
+            uint32_t child = node.firstChild + i;
+            if (child >= header->nodeCount) {
+                return -1;
+            }
+            const IndexNode& candidate = nodes[child];
+            if (x >= candidate.x && x < candidate.x + candidate.width &&
+                y >= candidate.y && y < candidate.y + candidate.height) {
+                next = child;
+                break;
+            }
+        }
+        // Index rusak: anak tidak memuat titik atau tidak bergerak maju
+        if (next <= index) {
+            return -1;
+        }
+        index = next;
+    }
+    return static_cast<int>(index);
+}
+
+RGB TreeIndex::getColorAt(int x, int y) const {
+    int leaf = findLeaf(x, y);
+    return leaf < 0 ? RGB(0, 0, 0) : leafColor(nodes[leaf], x, y);
+}
+
+void TreeIndex::render(vector<vector<RGB>>& image) const {
+    image.assign(getHeight(), vector<RGB>(getWidth()));
+    for (int i = 0; i < getNodeCount(); i++) {
+        const IndexNode& node = nodes[i];
+        if (!node.isLeaf) {
+            continue;
+        }
+        int endX = std::min<int>(node.x + node.width, getWidth());
+        int endY = std::min<int>(node.y + node.height, getHeight());
+        for (int y = node.y; y < endY; y++) {
+            for (int x = node.x; x < endX; x++) {
+                image[y][x] = leafColor(node, x, y);
+            }
+        }
+    }
+}
+
+RGB TreeIndex::leafColor(const IndexNode& node, int x, int y) const {
+    LeafModel::Type type = static_cast<LeafModel::Type>(header->leafModel);
+    if (type == LeafModel::FLAT) {
+        return RGB(node.red, node.green, node.blue);
+    }
+
+    RGB corners[4];
+    for (int c = 0; c < 4; c++) {
+        corners[c] = RGB(node.corners[c * 3], node.corners[c * 3 + 1], node.corners[c * 3 + 2]);
+    }
+    Block region(node.x, node.y, node.width, node.height);
+    if (type == LeafModel::PLANAR) {
+        PlanarModel model;
+        model.setCorners(region, corners);
+        return model.predict(x, y);
+    }
+    BilinearModel model;
+    model.setCorners(region, corners);
+    return model.predict(x, y);
+}
@@ -0,0 +1,119 @@
+#ifndef __TREE_INDEX__HPP__
+#define __TREE_INDEX__HPP__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "QuadTree.hpp"
+#include "RGB.hpp"
+
+using namespace std;
+
+/**
+ * @class TreeIndex
+ * @brief File index .qti: array node tanpa kompresi dengan offset anak, di-mmap dan
+ *        di-query langsung tanpa parsing. Node disusun breadth-first sehingga anak-anak
+ *        sebuah node bersebelahan; layout mengikuti urutan byte little-endian
+ */
+class TreeIndex {
+public:
+
+    // Header file, 32 byte
+    struct Header {
+        char magic[4];          // "QTI1"
+        uint32_t width;
+        uint32_t height;
+        uint32_t nodeCount;
+        uint32_t leafModel;     // LeafModel::Type
+        uint32_t partition;     // QuadTree::PartitionMode
+        uint32_t reserved[2];
+    };
+
+    // Satu node, 32 byte dan rata 4 byte
+    struct IndexNode {
+        uint16_t x, y, width, height;
+        uint8_t red, green, blue;
+        uint8_t isLeaf;
+        uint32_t firstChild;    // Index anak pertama (anak-anak bersebelahan)
+        uint8_t childCount;
+        uint8_t padding[3];
+        uint8_t corners[12];    // Warna pojok leaf model (RGB x 4)
+    };
+
+private:
+    const unsigned char* data;  // Awal file yang di-map
+    size_t size;
+    const Header* header;
+    const IndexNode* nodes;
+
+    // Handle platform untuk mapping
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+
+public:
+    TreeIndex();
+    ~TreeIndex();
+
+    TreeIndex(const TreeIndex&) = delete;
+    TreeIndex& operator=(const TreeIndex&) = delete;
+
+    /**
+     * @brief Menulis QuadTree yang sudah dibangun sebagai file index
+     * @param QuadTree sumber
+     * @param Path file output
+     * @return true jika berhasil
+     */
+    static bool write(const QuadTree&, const string&);
+
+    /**
+     * @brief Me-map file index (read-only, dapat dibagi antar proses)
+     * @param Path file index
+     * @return true jika file valid
+     */
+    bool open(const string&);
+
+    /**
+     * @brief Melepas mapping file
+     */
+    void close();
+
+    bool isOpen() const;
+    int getWidth() const;
+    int getHeight() const;
+    int getNodeCount() const;
+    const IndexNode& getNode(int) const;
+
+    /**
+     * @brief Mencari leaf yang memuat sebuah titik dengan menelusuri tree dari root
+     * @param Koordinat x
+     * @param Koordinat y
+     * @return Index leaf, -1 jika titik di luar gambar
+     */
+    int findLeaf(int, int) const;
+
+    /**
+     * @brief Warna gambar terkompresi pada sebuah titik
+     * @param Koordinat x
+     * @param Koordinat y
+     * @return Warna (hitam jika di luar gambar)
+     */
+    RGB getColorAt(int, int) const;
+
+    /**
+     * @brief Merender seluruh gambar dari index
+     * @param Gambar output
+     */
+    void render(vector<vector<RGB>>&) const;
+
+private:
+    /**
+     * @brief Warna leaf pada sebuah titik (rata-rata atau prediksi leaf model)
+     */
+    RGB leafColor(const IndexNode&, int, int) const;
+};
+
+#endif
@@ -4,6 +4,17 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <dirent.h>
+#endif
 
 
 void Utils::getThresholdLimits(QuadTree::ErrorMetricType method, double& minThreshold, double& maxThreshold) {
@@ -134,6 +145,118 @@ size_t Utils::getFileSize(const std::string& filePath) {
     return static_cast<size_t>(file.tellg());
 }
 
+bool Utils::isDirectory(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && (info.st_mode & S_IFDIR) != 0;
+}
+
+std::vector<std::string> Utils::listDirectory(const std::string& dirPath) {
+    std::vector<std::string> names;
+#ifdef _WIN32
+    struct _finddata_t entry;
+    intptr_t handle = _findfirst((dirPath + "\\*").c_str(), &entry);
+    if (handle != -1) {
+        do {
+            if (!(entry.attrib & _A_SUBDIR)) {
+                names.push_back(entry.name);
+            }
+        } while (_findnext(handle, &entry) == 0);
+        _findclose(handle);
+    }
+#else
+    DIR* dir = opendir(dirPath.c_str());
+    if (dir) {
+        while (struct dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name != "." && name != ".." && !isDirectory(dirPath + "/" + name)) {
+                names.push_back(name);
+            }
+        }
+        closedir(dir);
+    }
+#endif
+    std::sort(names.begin(), names.end());
+
+    std::string prefix = dirPath;
+    if (!prefix.empty() && prefix.back() != '/' && prefix.back() != '\\') {
+        prefix += '/';
+    }
+    for (std::string& name : names) {
+        name = prefix + name;
+    }
+    return names;
+}
+
+bool Utils::matchesWildcard(const std::string& pattern, const std::string& name) {
+    // Greedy dengan backtrack ke * terakhir
+    size_t p = 0, n = 0, star = std::string::npos, mark = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            p++;
+            n++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            mark = n;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            n = ++mark;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+bool Utils::parseValueList(const std::string& text, std::vector<double>& values) {
+    values.clear();
+    std::stringstream items(text);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        double range[3] = { 0.0, 0.0, 1.0 };
+        int parts = 0;
+        std::stringstream fields(item);
+        std::string field;
+        while (std::getline(fields, field, ':')) {
+            if (parts == 3) {
+                return false;
+            }
+            try {
+                size_t used = 0;
+                range[parts++] = std::stod(field, &used);
+                if (used != field.size()) {
+                    return false;
+                }
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+        if (parts == 0) {
+            return false;
+        }
+        if (parts == 1) {
+            values.push_back(range[0]);
+            continue;
+        }
+        if (range[2] <= 0.0 || range[1] < range[0]) {
+            return false;
+        }
+        // Langkah dihitung dari index agar akhir rentang tidak hilang karena pembulatan; jumlah
+        // nilai dibatasi sebelum dikonversi ke int agar rentang yang sangat besar ditolak
+        double steps = std::floor((range[1] - range[0]) / range[2] + 1e-9);
+        if (!(steps < MAX_RANGE_VALUES)) {
+            std::cerr << "Error: Range '" << item << "' has more than " << MAX_RANGE_VALUES << " values" << std::endl;
+            return false;
+        }
+        for (int i = 0; i <= static_cast<int>(steps); i++) {
+            values.push_back(range[0] + i * range[2]);
+        }
+    }
+    return !values.empty();
+}
+
 std::string Utils::getFileExtension(const std::string& filePath) {
     size_t dotPos = filePath.find_last_of('.');
     if (dotPos != std::string::npos) {
@@ -155,6 +278,24 @@ std::string Utils::errorMetricToString(QuadTree::ErrorMetricType method) {
     }
 }
 
+std::string Utils::leafModelToString(LeafModel::Type type) {
+    switch (type) {
+        case LeafModel::FLAT: return "Flat (average color)";
+        case LeafModel::PLANAR: return "Planar (a + bx + cy)";
+        case LeafModel::BILINEAR: return "Bilinear (4 corners)";
+        default: return "Unknown";
+    }
+}
+
+std::string Utils::partitionModeToString(QuadTree::PartitionMode mode) {
+    switch (mode) {
+        case QuadTree::QUADRANT: return "Quadrant (midpoint)";
+        case QuadTree::ADAPTIVE_BINARY: return "Adaptive binary";
+        case QuadTree::ADAPTIVE_QUAD: return "Adaptive quad";
+        default: return "Unknown";
+    }
+}
+
 double Utils::getDefaultThreshold(QuadTree::ErrorMetricType method) {
     switch (method) {
         case QuadTree::VARIANCE: return 20.0;
@@ -170,6 +311,39 @@ int Utils::getDefaultMinBlockArea() {
     return 16; 
 }
 
+int Utils::getDefaultThreadCount() {
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 0 ? static_cast<int>(cores) : 1;
+}
+
+void Utils::parallelFor(int count, int threadCount, const std::function<void(int)>& task) {
+    if (threadCount <= 0) {
+        threadCount = getDefaultThreadCount();
+    }
+    threadCount = std::min(threadCount, count);
+
+    if (threadCount <= 1) {
+        for (int i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    // Setiap worker mengambil index task berikutnya dari counter bersama
+    std::atomic<int> nextIndex(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&]() {
+            for (int i = nextIndex++; i < count; i = nextIndex++) {
+                task(i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
 
 bool Utils::createDirectoryIfNotExists(const std::string& dirPath) {
     if (dirPath.empty()) {
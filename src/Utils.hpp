@@ -2,6 +2,8 @@
 #define UTILS_HPP
 
 #include <string>
+#include <vector>
+#include <functional>
 #include <cstring>  
 #include <cerrno>   
 #include "QuadTree.hpp"
@@ -21,10 +23,21 @@ namespace Utils {
     size_t getFileSize(const std::string& filePath);
     std::string getFileExtension(const std::string& filePath);
     bool createDirectoryIfNotExists(const std::string& dirPath);
+    bool isDirectory(const std::string& path);
+    // Path file reguler di dalam direktori (tidak rekursif), terurut
+    std::vector<std::string> listDirectory(const std::string& dirPath);
+    // Pencocokan nama file dengan wildcard * dan ?
+    bool matchesWildcard(const std::string& pattern, const std::string& name);
+    // Daftar nilai "a,b,c" dengan rentang "awal:akhir[:langkah]" (inklusif), mis. "4,16:64:16";
+    // satu rentang berisi paling banyak MAX_RANGE_VALUES nilai
+    const int MAX_RANGE_VALUES = 10000;
+    bool parseValueList(const std::string& text, std::vector<double>& values);
     
     
 
     std::string errorMetricToString(QuadTree::ErrorMetricType method);
+    std::string leafModelToString(LeafModel::Type type);
+    std::string partitionModeToString(QuadTree::PartitionMode mode);
     double getDefaultThreshold(QuadTree::ErrorMetricType method);
     int getDefaultMinBlockArea();
     void getThresholdLimits(QuadTree::ErrorMetricType method, double& minThreshold, double& maxThreshold);
@@ -39,6 +52,10 @@ namespace Utils {
         double threshold, 
         int minBlockSize,
         double percentageCompression = 0.0);
+
+    int getDefaultThreadCount();
+    // Menjalankan task(0..count-1) secara paralel dengan sejumlah worker thread
+    void parallelFor(int count, int threadCount, const std::function<void(int)>& task);
 }
 
 #endif 
\ No newline at end of file
@@ -38,7 +38,7 @@
 // TEMP_MALLOC and TEMP_FREE will only be called in stack fashion - frees in the reverse order of mallocs
 // and any temp memory allocated by a function will be freed before it exits.
 // MALLOC and FREE are used only by GifBegin and GifEnd respectively (to allocate a buffer the size of the image, which
-// is used to find changed pixels for delta-encoding.)
+// is used to find changed pixels for delta-encoding, and the reusable LZW dictionary), and by GifLzwCreate/GifLzwFree.
 
 #ifndef GIF_TEMP_MALLOC
 #include <stdlib.h>
@@ -60,9 +60,15 @@
 #define GIF_FREE free
 #endif
 
+// REALLOC is used only to grow in-memory output buffers (see GifOutput).
+#ifndef GIF_REALLOC
+#include <stdlib.h>
+#define GIF_REALLOC realloc
+#endif
+
 const int kGifTransIndex = 0;
 
-typedef struct
+typedef struct GifPalette
 {
     int bitDepth;
 
@@ -380,6 +386,9 @@ int GifPickChangedPixels( const uint8_t* lastFrame, uint8_t* frame, int numPixel
 // This is known as the "median split" technique
 void GifMakePalette( const uint8_t* lastFrame, const uint8_t* nextFrame, uint32_t width, uint32_t height, int bitDepth, bool buildForDither, GifPalette* pPal )
 {
+    // with few changed pixels some k-d subtrees stay empty and are never written;
+    // clear them so the palette (and the encoded frame) does not depend on stack contents
+    memset(pPal, 0, sizeof(GifPalette));
     pPal->bitDepth = bitDepth;
 
     // SplitPalette is destructive (it sorts the pixels by color) so
@@ -550,54 +559,93 @@ void GifThresholdImage( const uint8_t* lastFrame, const uint8_t* nextFrame, uint
     }
 }
 
-// Simple structure to write out the LZW-compressed portion of the image
-// one bit at a time
+// Destination for encoded bytes: a file, or (when f is NULL) a growable memory buffer,
+// so frames can be encoded on several threads and written to the file later in order.
 typedef struct
 {
-    uint32_t chunkIndex;
-    uint8_t chunk[256];   // bytes are written in here until we have 256 of them, then written to the file
+    FILE* f;
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+} GifOutput;
 
-    uint8_t bitIndex;  // how many bits in the partial byte written so far
-    uint8_t byte;      // current partial byte
+GifOutput GifFileOutput( FILE* f )
+{
+    GifOutput out;
+    out.f = f;
+    out.data = NULL;
+    out.size = 0;
+    out.capacity = 0;
+    return out;
+}
 
-    uint8_t padding[2];    // make padding explicit
-} GifBitStatus;
+GifOutput GifMemoryOutput()
+{
+    return GifFileOutput(NULL);
+}
 
-// insert a single bit
-void GifWriteBit( GifBitStatus* stat, uint32_t bit )
+void GifOutputFree( GifOutput* out )
 {
-    bit = bit & 1;
-    bit = bit << stat->bitIndex;
-    stat->byte |= bit;
+    if( out->data ) GIF_FREE(out->data);
+    out->data = NULL;
+    out->size = 0;
+    out->capacity = 0;
+}
 
-    ++stat->bitIndex;
-    if( stat->bitIndex > 7 )
+void GifPutBytes( GifOutput* out, const void* bytes, size_t count )
+{
+    if( out->f )
     {
-        // move the newly-finished byte to the chunk buffer
-        stat->chunk[stat->chunkIndex++] = stat->byte;
-        // and start a new byte
-        stat->bitIndex = 0;
-        stat->byte = 0;
+        fwrite(bytes, 1, count, out->f);
+        return;
+    }
+    if( out->size + count > out->capacity )
+    {
+        size_t capacity = out->capacity? out->capacity : 4096;
+        while( capacity < out->size + count ) capacity *= 2;
+        out->data = (uint8_t*)GIF_REALLOC(out->data, capacity);
+        out->capacity = capacity;
     }
+    memcpy(out->data + out->size, bytes, count);
+    out->size += count;
+}
+
+void GifPutByte( GifOutput* out, int value )
+{
+    uint8_t byte = (uint8_t)value;
+    GifPutBytes(out, &byte, 1);
 }
 
-// write all bytes so far to the file
-void GifWriteChunk( FILE* f, GifBitStatus* stat )
+// Bit writer for the LZW-compressed portion of the image: codes are packed into a bit
+// accumulator and moved to the sub-block buffer a byte at a time; each full sub-block
+// (length byte + 255 data bytes) goes to the output in a single write
+typedef struct
+{
+    uint32_t bits;        // pending bits, least significant first
+    uint32_t bitCount;    // number of pending bits (always < 8 between codes)
+    uint32_t chunkIndex;  // data bytes in the current sub-block
+    uint8_t chunk[256];   // chunk[0] is the sub-block length, the data follows
+} GifBitStatus;
+
+// write the current sub-block to the output
+void GifWriteChunk( GifOutput* f, GifBitStatus* stat )
 {
-    fputc((int)stat->chunkIndex, f);
-    fwrite(stat->chunk, 1, stat->chunkIndex, f);
+    stat->chunk[0] = (uint8_t)stat->chunkIndex;
+    GifPutBytes(f, stat->chunk, stat->chunkIndex + 1);
 
-    stat->bitIndex = 0;
-    stat->byte = 0;
     stat->chunkIndex = 0;
 }
 
-void GifWriteCode( FILE* f, GifBitStatus* stat, uint32_t code, uint32_t length )
+void GifWriteCode( GifOutput* f, GifBitStatus* stat, uint32_t code, uint32_t length )
 {
-    for( uint32_t ii=0; ii<length; ++ii )
+    stat->bits |= code << stat->bitCount;
+    stat->bitCount += length;
+
+    while( stat->bitCount >= 8 )
     {
-        GifWriteBit(stat, code);
-        code = code >> 1;
+        stat->chunk[1 + stat->chunkIndex++] = (uint8_t)stat->bits;
+        stat->bits >>= 8;
+        stat->bitCount -= 8;
 
         if( stat->chunkIndex == 255 )
         {
@@ -606,19 +654,73 @@ void GifWriteCode( FILE* f, GifBitStatus* stat, uint32_t code, uint32_t length )
     }
 }
 
-// The LZW dictionary is a 256-ary tree constructed as the file is encoded,
-// this is one node
-typedef struct
+// write out the last partial byte and sub-block
+void GifFlushCodes( GifOutput* f, GifBitStatus* stat )
 {
-    uint16_t m_next[256];
-} GifLzwNode;
+    if( stat->bitCount )
+    {
+        GifWriteCode(f, stat, 0, 8 - stat->bitCount);
+    }
+    if( stat->chunkIndex ) GifWriteChunk(f, stat);
+}
+
+// The LZW dictionary maps (prefix code, next index) pairs to codes with an open-addressing
+// hash table. It is allocated once and reused for every frame: clearing it only bumps the
+// generation, and slots stamped with an older generation count as empty.
+#define kGifLzwHashBits 13
+const uint32_t kGifLzwHashSize = 1u << kGifLzwHashBits;  // twice the 4096 possible codes
+
+typedef struct GifLzwTable
+{
+    uint32_t keys[kGifLzwHashSize];     // prefix code << 8 | next index
+    uint32_t stamps[kGifLzwHashSize];   // generation in which the slot was filled
+    uint16_t codes[kGifLzwHashSize];
+    uint32_t generation;
+} GifLzwTable;
+
+GifLzwTable* GifLzwCreate()
+{
+    GifLzwTable* table = (GifLzwTable*)GIF_MALLOC(sizeof(GifLzwTable));
+    if( table )
+    {
+        memset(table->stamps, 0, sizeof(table->stamps));
+        table->generation = 0;
+    }
+    return table;
+}
+
+void GifLzwFree( GifLzwTable* table )
+{
+    if( table ) GIF_FREE(table);
+}
+
+void GifLzwClear( GifLzwTable* table )
+{
+    if( ++table->generation == 0 )
+    {
+        // generation wrapped around, old stamps could look current again
+        memset(table->stamps, 0, sizeof(table->stamps));
+        table->generation = 1;
+    }
+}
+
+// returns the slot holding key, or the empty slot where it would be inserted
+uint32_t GifLzwFind( const GifLzwTable* table, uint32_t key )
+{
+    uint32_t slot = (key * 2654435761u) >> (32 - kGifLzwHashBits);
+    while( table->stamps[slot] == table->generation && table->keys[slot] != key )
+    {
+        slot = (slot + 1) & (kGifLzwHashSize - 1);
+    }
+    return slot;
+}
 
 // write a 256-color (8-bit) image palette to the file
-void GifWritePalette( const GifPalette* pPal, FILE* f )
+void GifWritePalette( const GifPalette* pPal, GifOutput* f )
 {
-    fputc(0, f);  // first color: transparency
-    fputc(0, f);
-    fputc(0, f);
+    GifPutByte(f, 0);  // first color: transparency
+    GifPutByte(f, 0);
+    GifPutByte(f, 0);
 
     for(int ii=1; ii<(1 << pPal->bitDepth); ++ii)
     {
@@ -626,58 +728,72 @@ void GifWritePalette( const GifPalette* pPal, FILE* f )
         uint32_t g = pPal->g[ii];
         uint32_t b = pPal->b[ii];
 
-        fputc((int)r, f);
-        fputc((int)g, f);
-        fputc((int)b, f);
+        GifPutByte(f, (int)r);
+        GifPutByte(f, (int)g);
+        GifPutByte(f, (int)b);
     }
 }
 
 // write the image header, LZW-compress and write out the image
-void GifWriteLzwImage(FILE* f, uint8_t* image, uint32_t left, uint32_t top,  uint32_t width, uint32_t height, uint32_t delay, GifPalette* pPal)
+// (with localPalette false, the frame uses the global color table and pPal only supplies the bit depth;
+// without a dictionary a temporary one is allocated for this image)
+void GifWriteLzwImage(GifOutput* f, const uint8_t* image, uint32_t left, uint32_t top,  uint32_t width, uint32_t height, uint32_t delay, const GifPalette* pPal, bool localPalette = true, GifLzwTable* dictionary = NULL)
 {
     // graphics control extension
-    fputc(0x21, f);
-    fputc(0xf9, f);
-    fputc(0x04, f);
-    fputc(0x05, f); // leave prev frame in place, this frame has transparency
-    fputc(delay & 0xff, f);
-    fputc((delay >> 8) & 0xff, f);
-    fputc(kGifTransIndex, f); // transparent color index
-    fputc(0, f);
-
-    fputc(0x2c, f); // image descriptor block
-
-    fputc(left & 0xff, f);           // corner of image in canvas space
-    fputc((left >> 8) & 0xff, f);
-    fputc(top & 0xff, f);
-    fputc((top >> 8) & 0xff, f);
-
-    fputc(width & 0xff, f);          // width and height of image
-    fputc((width >> 8) & 0xff, f);
-    fputc(height & 0xff, f);
-    fputc((height >> 8) & 0xff, f);
-
-    //fputc(0, f); // no local color table, no transparency
-    //fputc(0x80, f); // no local color table, but transparency
-
-    fputc(0x80 + pPal->bitDepth-1, f); // local color table present, 2 ^ bitDepth entries
-    GifWritePalette(pPal, f);
+    GifPutByte(f, 0x21);
+    GifPutByte(f, 0xf9);
+    GifPutByte(f, 0x04);
+    GifPutByte(f, 0x05); // leave prev frame in place, this frame has transparency
+    GifPutByte(f, delay & 0xff);
+    GifPutByte(f, (delay >> 8) & 0xff);
+    GifPutByte(f, kGifTransIndex); // transparent color index
+    GifPutByte(f, 0);
+
+    GifPutByte(f, 0x2c); // image descriptor block
+
+    GifPutByte(f, left & 0xff);           // corner of image in canvas space
+    GifPutByte(f, (left >> 8) & 0xff);
+    GifPutByte(f, top & 0xff);
+    GifPutByte(f, (top >> 8) & 0xff);
+
+    GifPutByte(f, width & 0xff);          // width and height of image
+    GifPutByte(f, (width >> 8) & 0xff);
+    GifPutByte(f, height & 0xff);
+    GifPutByte(f, (height >> 8) & 0xff);
+
+    //GifPutByte(f, 0); // no local color table, no transparency
+    //GifPutByte(f, 0x80); // no local color table, but transparency
+
+    if( localPalette )
+    {
+        GifPutByte(f, 0x80 + pPal->bitDepth-1); // local color table present, 2 ^ bitDepth entries
+        GifWritePalette(pPal, f);
+    }
+    else
+    {
+        GifPutByte(f, 0); // no local color table, the global one applies
+    }
 
     const int minCodeSize = pPal->bitDepth;
     const uint32_t clearCode = 1 << pPal->bitDepth;
 
-    fputc(minCodeSize, f); // min code size 8 bits
+    GifPutByte(f, minCodeSize); // min code size 8 bits
 
-    GifLzwNode* codetree = (GifLzwNode*)GIF_TEMP_MALLOC(sizeof(GifLzwNode)*4096);
+    GifLzwTable* table = dictionary? dictionary : (GifLzwTable*)GIF_TEMP_MALLOC(sizeof(GifLzwTable));
+    if( !dictionary )
+    {
+        memset(table->stamps, 0, sizeof(table->stamps));
+        table->generation = 0;
+    }
+    GifLzwClear(table);
 
-    memset(codetree, 0, sizeof(GifLzwNode)*4096);
     int32_t curCode = -1;
     uint32_t codeSize = (uint32_t)minCodeSize + 1;
     uint32_t maxCode = clearCode+1;
 
     GifBitStatus stat;
-    stat.byte = 0;
-    stat.bitIndex = 0;
+    stat.bits = 0;
+    stat.bitCount = 0;
     stat.chunkIndex = 0;
 
     GifWriteCode(f, &stat, clearCode, codeSize);  // start with a fresh LZW dictionary
@@ -702,11 +818,15 @@ void GifWriteLzwImage(FILE* f, uint8_t* image, uint32_t left, uint32_t top,  uin
             {
                 // first value in a new run
                 curCode = nextValue;
+                continue;
             }
-            else if( codetree[curCode].m_next[nextValue] )
+
+            uint32_t key = ((uint32_t)curCode << 8) | nextValue;
+            uint32_t slot = GifLzwFind(table, key);
+            if( table->stamps[slot] == table->generation )
             {
                 // current run already in the dictionary
-                curCode = codetree[curCode].m_next[nextValue];
+                curCode = table->codes[slot];
             }
             else
             {
@@ -714,7 +834,9 @@ void GifWriteLzwImage(FILE* f, uint8_t* image, uint32_t left, uint32_t top,  uin
                 GifWriteCode(f, &stat, (uint32_t)curCode, codeSize);
 
                 // insert the new run into the dictionary
-                codetree[curCode].m_next[nextValue] = (uint16_t)++maxCode;
+                table->keys[slot] = key;
+                table->stamps[slot] = table->generation;
+                table->codes[slot] = (uint16_t)++maxCode;
 
                 if( maxCode >= (1ul << codeSize) )
                 {
@@ -727,7 +849,7 @@ void GifWriteLzwImage(FILE* f, uint8_t* image, uint32_t left, uint32_t top,  uin
                     // the dictionary is full, clear it out and begin anew
                     GifWriteCode(f, &stat, clearCode, codeSize); // clear tree
 
-                    memset(codetree, 0, sizeof(GifLzwNode)*4096);
+                    GifLzwClear(table);
                     codeSize = (uint32_t)(minCodeSize + 1);
                     maxCode = clearCode+1;
                 }
@@ -739,22 +861,28 @@ void GifWriteLzwImage(FILE* f, uint8_t* image, uint32_t left, uint32_t top,  uin
 
     // compression footer
     GifWriteCode(f, &stat, (uint32_t)curCode, codeSize);
+    // the decoder adds one more dictionary entry after reading the last code,
+    // which may widen the code size it uses to read the clear code
+    if( maxCode + 1 >= (1ul << codeSize) && codeSize < 12 )
+    {
+        codeSize++;
+    }
     GifWriteCode(f, &stat, clearCode, codeSize);
     GifWriteCode(f, &stat, clearCode + 1, (uint32_t)minCodeSize + 1);
 
     // write out the last partial chunk
-    while( stat.bitIndex ) GifWriteBit(&stat, 0);
-    if( stat.chunkIndex ) GifWriteChunk(f, &stat);
+    GifFlushCodes(f, &stat);
 
-    fputc(0, f); // image block terminator
+    GifPutByte(f, 0); // image block terminator
 
-    GIF_TEMP_FREE(codetree);
+    if( !dictionary ) GIF_TEMP_FREE(table);
 }
 
-typedef struct
+typedef struct GifWriter
 {
     FILE* f;
     uint8_t* oldImage;
+    GifLzwTable* lzw;     // LZW dictionary shared by all frames
     bool firstFrame;
 
     uint8_t padding[7];    // make padding explicit
@@ -763,7 +891,9 @@ typedef struct
 // Creates a gif file.
 // The input GIFWriter is assumed to be uninitialized.
 // The delay value is the time between frames in hundredths of a second - note that not all viewers pay much attention to this value.
-bool GifBegin( GifWriter* writer, const char* filename, uint32_t width, uint32_t height, uint32_t delay, int32_t bitDepth = 8, bool dither = false )
+// If globalPal is given it is written as the global color table (entry 0 stays the transparent color),
+// for frames written with GifWriteIndexedFrameRect.
+bool GifBegin( GifWriter* writer, const char* filename, uint32_t width, uint32_t height, uint32_t delay, int32_t bitDepth = 8, bool dither = false, const GifPalette* globalPal = NULL )
 {
     (void)bitDepth; (void)dither; // Mute "Unused argument" warnings
 #if defined(_MSC_VER) && (_MSC_VER >= 1400)
@@ -778,6 +908,7 @@ bool GifBegin( GifWriter* writer, const char* filename, uint32_t width, uint32_t
 
     // allocate
     writer->oldImage = (uint8_t*)GIF_MALLOC(width*height*4);
+    writer->lzw = GifLzwCreate();
 
     fputs("GIF89a", writer->f);
 
@@ -787,19 +918,30 @@ bool GifBegin( GifWriter* writer, const char* filename, uint32_t width, uint32_t
     fputc(height & 0xff, writer->f);
     fputc((height >> 8) & 0xff, writer->f);
 
-    fputc(0xf0, writer->f);  // there is an unsorted global color table of 2 entries
-    fputc(0, writer->f);     // background color
-    fputc(0, writer->f);     // pixels are square (we need to specify this because it's 1989)
-
-    // now the "global" palette (really just a dummy palette)
-    // color 0: black
-    fputc(0, writer->f);
-    fputc(0, writer->f);
-    fputc(0, writer->f);
-    // color 1: also black
-    fputc(0, writer->f);
-    fputc(0, writer->f);
-    fputc(0, writer->f);
+    if( globalPal )
+    {
+        fputc(0xf0 + globalPal->bitDepth-1, writer->f);  // unsorted global color table, 2 ^ bitDepth entries
+        fputc(0, writer->f);     // background color
+        fputc(0, writer->f);     // pixels are square
+        GifOutput out = GifFileOutput(writer->f);
+        GifWritePalette(globalPal, &out);
+    }
+    else
+    {
+        fputc(0xf0, writer->f);  // there is an unsorted global color table of 2 entries
+        fputc(0, writer->f);     // background color
+        fputc(0, writer->f);     // pixels are square (we need to specify this because it's 1989)
+
+        // now the "global" palette (really just a dummy palette)
+        // color 0: black
+        fputc(0, writer->f);
+        fputc(0, writer->f);
+        fputc(0, writer->f);
+        // color 1: also black
+        fputc(0, writer->f);
+        fputc(0, writer->f);
+        fputc(0, writer->f);
+    }
 
     if( delay != 0 )
     {
@@ -839,7 +981,141 @@ bool GifWriteFrame( GifWriter* writer, const uint8_t* image, uint32_t width, uin
     else
         GifThresholdImage(oldImage, image, writer->oldImage, width, height, &pal);
 
-    GifWriteLzwImage(writer->f, writer->oldImage, 0, 0, width, height, delay, &pal);
+    GifOutput out = GifFileOutput(writer->f);
+    GifWriteLzwImage(&out, writer->oldImage, 0, 0, width, height, delay, &pal, true, writer->lzw);
+
+    return true;
+}
+
+// Encodes one frame covering the canvas rectangle (left, top, rectWidth, rectHeight) into out.
+// nextRect holds the new RGBA8 pixels of the rectangle and lastRect its previous contents
+// (NULL for the first frame); the palette is built from the changed pixels only and pixels equal
+// to lastRect are written as transparent. outRect (rectWidth x rectHeight RGBA8) receives the
+// quantized rectangle. Needs no GifWriter, so frames can be encoded on any thread; each thread
+// may pass its own reusable dictionary.
+bool GifEncodeFrameRect( const uint8_t* lastRect, const uint8_t* nextRect, uint8_t* outRect,
+                         uint32_t left, uint32_t top, uint32_t rectWidth, uint32_t rectHeight,
+                         uint32_t delay, int bitDepth, GifOutput* out, GifLzwTable* dictionary = NULL )
+{
+    if(rectWidth == 0 || rectHeight == 0) return false;
+
+    GifPalette pal;
+    GifMakePalette(lastRect, nextRect, rectWidth, rectHeight, bitDepth, false, &pal);
+    GifThresholdImage(lastRect, nextRect, outRect, rectWidth, rectHeight, &pal);
+    GifWriteLzwImage(out, outRect, left, top, rectWidth, rectHeight, delay, &pal, true, dictionary);
+
+    return true;
+}
+
+// Encodes one frame of palette indices (one byte per pixel, rectWidth x rectHeight) that refer to
+// the global palette given to GifBegin. Indices equal to lastIndices (NULL for the first frame) are
+// written as transparent; no palette is built and no color matching is done.
+bool GifEncodeIndexedRect( const uint8_t* lastIndices, const uint8_t* nextIndices,
+                           uint32_t left, uint32_t top, uint32_t rectWidth, uint32_t rectHeight,
+                           uint32_t delay, int bitDepth, GifOutput* out, GifLzwTable* dictionary = NULL )
+{
+    if(rectWidth == 0 || rectHeight == 0) return false;
+
+    size_t pixelCount = (size_t)rectWidth * rectHeight;
+    uint8_t* rect = (uint8_t*)GIF_TEMP_MALLOC(pixelCount * 4);
+    for(size_t ii=0; ii<pixelCount; ++ii)
+    {
+        rect[ii*4+3] = (lastIndices && lastIndices[ii] == nextIndices[ii])? (uint8_t)kGifTransIndex : nextIndices[ii];
+    }
+
+    GifPalette pal;
+    pal.bitDepth = bitDepth;
+    GifWriteLzwImage(out, rect, left, top, rectWidth, rectHeight, delay, &pal, false, dictionary);
+
+    GIF_TEMP_FREE(rect);
+
+    return true;
+}
+
+// Appends a frame produced by GifEncodeFrameRect or GifEncodeIndexedRect to the file.
+// Frames must be appended in display order.
+bool GifWriteEncodedFrame( GifWriter* writer, const uint8_t* data, size_t size )
+{
+    if(!writer->f) return false;
+
+    writer->firstFrame = false;
+    return fwrite(data, 1, size, writer->f) == size;
+}
+
+// Writes out a new frame that only covers the sub-rectangle (left, top, rectWidth, rectHeight)
+// of the canvas. The image is the full canvas (width x height RGBA8); pixels outside the rectangle
+// must be unchanged since the previous frame. The palette is built from the changed pixels inside
+// the rectangle only, and unchanged pixels inside it are written as transparent.
+bool GifWriteFrameRect( GifWriter* writer, const uint8_t* image, uint32_t width, uint32_t height,
+                        uint32_t left, uint32_t top, uint32_t rectWidth, uint32_t rectHeight,
+                        uint32_t delay, int bitDepth = 8 )
+{
+    if(!writer->f) return false;
+    if(rectWidth == 0 || rectHeight == 0 || left + rectWidth > width || top + rectHeight > height) return false;
+
+    const bool firstFrame = writer->firstFrame;
+    writer->firstFrame = false;
+
+    size_t rowBytes = (size_t)rectWidth * 4;
+    size_t rectSize = rowBytes * rectHeight;
+    uint8_t* nextRect = (uint8_t*)GIF_TEMP_MALLOC(rectSize);
+    uint8_t* lastRect = (uint8_t*)GIF_TEMP_MALLOC(rectSize);
+    uint8_t* outRect = (uint8_t*)GIF_TEMP_MALLOC(rectSize);
+
+    for(uint32_t yy=0; yy<rectHeight; ++yy)
+    {
+        size_t canvasOffset = ((size_t)(top + yy) * width + left) * 4;
+        memcpy(nextRect + yy * rowBytes, image + canvasOffset, rowBytes);
+        memcpy(lastRect + yy * rowBytes, writer->oldImage + canvasOffset, rowBytes);
+    }
+
+    GifOutput out = GifFileOutput(writer->f);
+    GifEncodeFrameRect(firstFrame? NULL : lastRect, nextRect, outRect, left, top, rectWidth, rectHeight, delay, bitDepth, &out, writer->lzw);
+
+    for(uint32_t yy=0; yy<rectHeight; ++yy)
+    {
+        size_t canvasOffset = ((size_t)(top + yy) * width + left) * 4;
+        memcpy(writer->oldImage + canvasOffset, outRect + yy * rowBytes, rowBytes);
+    }
+
+    GIF_TEMP_FREE(outRect);
+    GIF_TEMP_FREE(lastRect);
+    GIF_TEMP_FREE(nextRect);
+
+    return true;
+}
+
+// Writes out a new frame from a canvas of palette indices (one byte per pixel, width x height)
+// that refer to the global palette given to GifBegin. Only the sub-rectangle
+// (left, top, rectWidth, rectHeight) is encoded; pixels whose index did not change since the
+// previous frame are written as transparent.
+bool GifWriteIndexedFrameRect( GifWriter* writer, const uint8_t* indices, uint32_t width, uint32_t height,
+                               uint32_t left, uint32_t top, uint32_t rectWidth, uint32_t rectHeight,
+                               uint32_t delay, int bitDepth = 8 )
+{
+    if(!writer->f) return false;
+    if(rectWidth == 0 || rectHeight == 0 || left + rectWidth > width || top + rectHeight > height) return false;
+
+    // oldImage holds the index canvas of the previous frame (one byte per pixel)
+    const bool firstFrame = writer->firstFrame;
+    writer->firstFrame = false;
+
+    size_t rectSize = (size_t)rectWidth * rectHeight;
+    uint8_t* nextRect = (uint8_t*)GIF_TEMP_MALLOC(rectSize);
+    uint8_t* lastRect = (uint8_t*)GIF_TEMP_MALLOC(rectSize);
+    for(uint32_t yy=0; yy<rectHeight; ++yy)
+    {
+        size_t canvasOffset = (size_t)(top + yy) * width + left;
+        memcpy(nextRect + (size_t)yy * rectWidth, indices + canvasOffset, rectWidth);
+        memcpy(lastRect + (size_t)yy * rectWidth, writer->oldImage + canvasOffset, rectWidth);
+        memcpy(writer->oldImage + canvasOffset, indices + canvasOffset, rectWidth);
+    }
+
+    GifOutput out = GifFileOutput(writer->f);
+    GifEncodeIndexedRect(firstFrame? NULL : lastRect, nextRect, left, top, rectWidth, rectHeight, delay, bitDepth, &out, writer->lzw);
+
+    GIF_TEMP_FREE(lastRect);
+    GIF_TEMP_FREE(nextRect);
 
     return true;
 }
@@ -854,9 +1130,11 @@ bool GifEnd( GifWriter* writer )
     fputc(0x3b, writer->f); // end of file
     fclose(writer->f);
     GIF_FREE(writer->oldImage);
+    GifLzwFree(writer->lzw);
 
     writer->f = NULL;
     writer->oldImage = NULL;
+    writer->lzw = NULL;
 
     return true;
 }
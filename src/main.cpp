@@ -1,7 +1,12 @@
 #include <iostream>
 #include <string>
 #include <iomanip>
+#include <vector>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
 #include "ImageProcessor.hpp"
+#include "BatchProcessor.hpp"
 #include "Utils.hpp"
 
 
@@ -20,13 +25,34 @@ void printColoredText(const std::string& text, const std::string& color) {
 void displayUsage(const char* programName) {
     std::cout << "Usage: " << programName << " <options>\n";
     std::cout << "Options:\n";
-    std::cout << "  -i, --input <file>            Input image file path\n";
-    std::cout << "  -o, --output <file>           Output compressed image file path\n";
+    std::cout << "  -i, --input <file>            Input image file path (.qtc/.qtp/.qti/.qoi files are decoded)\n";
+    std::cout << "  -o, --output <file>           Output compressed image file path (.qtc/.qtp/.qti = tree formats, .svg/.svgz = vector, .qoi/.ppm = raw raster)\n";
     std::cout << "  -m, --method <number>         Error metric method (1=Variance, 2=MAD, 3=MaxDiff, 4=Entropy, 5=SSIM)\n";
     std::cout << "  -t, --threshold <number>      Error threshold\n";
     std::cout << "  -b, --blocksize <number>      Minimum block area in square pixels\n";
     std::cout << "  -c, --compression <percent>   Target compression percentage (0.0-1.0, 0 to disable)\n";
     std::cout << "  -g, --gif <file>              Output GIF visualization file path (optional)\n";
+    std::cout << "  --batch <dir|pattern|list>    Compress every image in a directory, wildcard pattern or list file\n";
+    std::cout << "  --sweep <csv file>            Compress every -m/-t/-b combination (lists a,b or ranges start:end:step)\n";
+    std::cout << "  --roi <file>                  Grayscale importance mask (white = fine blocks, black = coarse)\n";
+    std::cout << "  --roi-rect <x,y,w,h>          Important rectangle (repeatable)\n";
+    std::cout << "  --roi-strength <number>       ROI threshold scale k: x1/k on important, xk on background (default: 4)\n";
+    std::cout << "  --channels <mode>             joint (default), rgb or ycbcr: separate quadtree per channel\n";
+    std::cout << "  --leaf-model <type>           flat (default), planar or bilinear color model per leaf\n";
+    std::cout << "  --partition <mode>            quadrant (default), binary or quad: adaptive split positions\n";
+    std::cout << "  --max-bytes <number>          Byte limit for .qtp output (coarser levels are kept)\n";
+    std::cout << "  --jpeg-grid <8|16>            Snap splits to the JPEG MCU grid (blocks at least that size)\n";
+    std::cout << "  --jpeg-quality <1-100>        JPEG output quality (default: 90)\n";
+    std::cout << "  --band-height <rows>          Render and write .png/.bmp/.ppm output in bands of this many rows\n";
+    std::cout << "  --gif-palette <mode>          frame (default) or global: one palette from the tree's node colors\n";
+    std::cout << "  --gif-frames <number>         Render at most this many GIF frames, evenly spaced from coarse to fine\n";
+    std::cout << "  --gif-per-level               Render one GIF frame per tree depth\n";
+    std::cout << "  --gif-max-dim <pixels>        Render GIF frames with the longest side scaled down to this size\n";
+    std::cout << "  --video <file|->              Write the build animation as a raw Y4M/PPM frame stream ('-' = stdout)\n";
+    std::cout << "  --video-format <y4m|ppm>      Frame stream format (default: from the extension, else y4m)\n";
+    std::cout << "  --autotune                    Search methods, thresholds and block sizes in parallel\n";
+    std::cout << "  --goal <type:value>           Autotune goal: psnr:<dB>, ssim:<0-1> or size:<bytes>\n";
+    std::cout << "  -j, --threads <number>        Worker threads for parallel modes (default: all cores)\n";
     std::cout << "  -h, --help                    Display this help message\n";
     std::cout << "\nOr run without arguments to use interactive mode.\n";
 }
@@ -41,13 +67,95 @@ QuadTree::ErrorMetricType getErrorMetricFromString(const std::string& input) {
     return QuadTree::VARIANCE; 
 }
 
+bool parseRegion(const std::string& input, Block& region) {
+    int x, y, w, h;
+    if (std::sscanf(input.c_str(), "%d,%d,%d,%d", &x, &y, &w, &h) != 4 || w <= 0 || h <= 0) {
+        return false;
+    }
+    region = Block(x, y, w, h);
+    return true;
+}
+
+// Konversi angka yang menolak sisa karakter (mis. "10x") alih-alih mengabaikannya
+bool parseNumber(const std::string& input, double& value) {
+    try {
+        size_t used = 0;
+        value = std::stod(input, &used);
+        return used == input.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool parseInteger(const std::string& input, int& value) {
+    try {
+        size_t used = 0;
+        value = std::stoi(input, &used);
+        return used == input.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
 int main(int argc, char* argv[]) {
     std::string inputPath, outputPath, gifPath;
     QuadTree::ErrorMetricType errorMethod = QuadTree::VARIANCE;
     double threshold = -1.0; 
     int minBlockSize = Utils::getDefaultMinBlockArea();
     double targetCompression = 0.0;
+    bool autoTune = false;
+    AutoTuner::GoalType goalType = AutoTuner::NO_GOAL;
+    double goalValue = 0.0;
+    int threadCount = 0;
+    std::string roiMaskPath;
+    std::vector<Block> roiRegions;
+    double roiStrength = 4.0;
+    PlanarQuadTree::ChannelMode channelMode = PlanarQuadTree::JOINT;
+    LeafModel::Type leafModel = LeafModel::FLAT;
+    QuadTree::PartitionMode partitionMode = QuadTree::QUADRANT;
+    long long maxOutputBytes = 0;
+    int jpegGrid = 0;
+    int jpegQuality = 90;
+    int bandHeight = 0;
+    bool gifGlobalPalette = false;
+    int gifFrameCount = 0;
+    bool gifPerLevel = false;
+    int gifMaxDimension = 0;
+    std::string videoPath;
+    std::string videoFormatName;
+    std::string batchSpec;
+    std::string sweepCsvPath;
+    std::string methodSpec, thresholdSpec, blockSpec;
+    std::vector<QuadTree::ErrorMetricType> sweepMethods;
+    std::vector<double> sweepThresholds;
+    std::vector<int> sweepBlockSizes;
     bool interactiveMode = (argc <= 1);
+
+    // Opsi kompresi yang sama diterapkan ke processor tunggal maupun setiap gambar batch
+    auto configureProcessor = [&](ImageProcessor& processor) {
+        processor.setThreadCount(threadCount);
+        processor.setChannelMode(channelMode);
+        processor.setLeafModel(leafModel);
+        processor.setPartitionMode(partitionMode);
+        processor.setMaxOutputBytes(static_cast<size_t>(maxOutputBytes));
+        processor.setJpegGrid(jpegGrid);
+        processor.setJpegQuality(jpegQuality);
+        processor.setBandHeight(bandHeight);
+        processor.setGifGlobalPalette(gifGlobalPalette);
+        processor.setGifFrameCount(gifFrameCount);
+        processor.setGifPerLevel(gifPerLevel);
+        processor.setGifMaxDimension(gifMaxDimension);
+        if (!videoPath.empty()) {
+            FrameStreamWriter::Format videoFormat = videoFormatName.empty() ? FrameStreamWriter::formatFromPath(videoPath)
+                                                  : (videoFormatName == "ppm" ? FrameStreamWriter::PPM : FrameStreamWriter::Y4M);
+            processor.setVideoOutput(videoPath, videoFormat);
+        }
+        processor.setRoiMask(roiMaskPath);
+        processor.setRoiStrength(roiStrength);
+        for (const Block& region : roiRegions) {
+            processor.addRoiRegion(region);
+        }
+    };
     
     
     if (!interactiveMode) {
@@ -61,19 +169,220 @@ int main(int argc, char* argv[]) {
                 if (i + 1 < argc) inputPath = argv[++i];
             } else if (arg == "-o" || arg == "--output") {
                 if (i + 1 < argc) outputPath = argv[++i];
+            } else if (arg == "--sweep") {
+                if (i + 1 < argc) sweepCsvPath = argv[++i];
+            } else if (arg == "--batch") {
+                if (i + 1 < argc) batchSpec = argv[++i];
             } else if (arg == "-m" || arg == "--method") {
-                if (i + 1 < argc) errorMethod = getErrorMetricFromString(argv[++i]);
+                if (i + 1 < argc) methodSpec = argv[++i];
             } else if (arg == "-t" || arg == "--threshold") {
-                if (i + 1 < argc) threshold = std::stod(argv[++i]);
+                if (i + 1 < argc) thresholdSpec = argv[++i];
             } else if (arg == "-b" || arg == "--blocksize") {
-                if (i + 1 < argc) minBlockSize = std::stoi(argv[++i]);
+                if (i + 1 < argc) blockSpec = argv[++i];
             } else if (arg == "-c" || arg == "--compression") {
                 if (i + 1 < argc) targetCompression = std::stod(argv[++i]);
             } else if (arg == "-g" || arg == "--gif") {
                 if (i + 1 < argc) gifPath = argv[++i];
+            } else if (arg == "--roi") {
+                if (i + 1 < argc) roiMaskPath = argv[++i];
+            } else if (arg == "--roi-rect") {
+                Block region;
+                if (i + 1 < argc) {
+                    if (!parseRegion(argv[++i], region)) {
+                        std::cerr << "Error: Invalid ROI rectangle '" << argv[i] << "' (expected x,y,w,h).\n";
+                        return 1;
+                    }
+                    roiRegions.push_back(region);
+                }
+            } else if (arg == "--roi-strength") {
+                if (i + 1 < argc) roiStrength = std::stod(argv[++i]);
+            } else if (arg == "--channels") {
+                if (i + 1 < argc) {
+                    std::string mode = argv[++i];
+                    if (mode == "rgb") channelMode = PlanarQuadTree::RGB_PLANES;
+                    else if (mode == "ycbcr") channelMode = PlanarQuadTree::YCBCR_PLANES;
+                    else if (mode == "joint") channelMode = PlanarQuadTree::JOINT;
+                    else {
+                        std::cerr << "Error: Invalid channel mode '" << mode << "' (expected joint, rgb or ycbcr).\n";
+                        return 1;
+                    }
+                }
+            } else if (arg == "--leaf-model") {
+                if (i + 1 < argc) {
+                    std::string model = argv[++i];
+                    if (model == "flat") leafModel = LeafModel::FLAT;
+                    else if (model == "planar") leafModel = LeafModel::PLANAR;
+                    else if (model == "bilinear") leafModel = LeafModel::BILINEAR;
+                    else {
+                        std::cerr << "Error: Invalid leaf model '" << model << "' (expected flat, planar or bilinear).\n";
+                        return 1;
+                    }
+                }
+            } else if (arg == "--partition") {
+                if (i + 1 < argc) {
+                    std::string mode = argv[++i];
+                    if (mode == "quadrant") partitionMode = QuadTree::QUADRANT;
+                    else if (mode == "binary") partitionMode = QuadTree::ADAPTIVE_BINARY;
+                    else if (mode == "quad") partitionMode = QuadTree::ADAPTIVE_QUAD;
+                    else {
+                        std::cerr << "Error: Invalid partition mode '" << mode << "' (expected quadrant, binary or quad).\n";
+                        return 1;
+                    }
+                }
+            } else if (arg == "--max-bytes") {
+                if (i + 1 < argc) maxOutputBytes = std::stoll(argv[++i]);
+                if (maxOutputBytes < 0) {
+                    std::cerr << "Error: --max-bytes must not be negative.\n";
+                    return 1;
+                }
+            } else if (arg == "--jpeg-grid") {
+                if (i + 1 < argc) jpegGrid = std::stoi(argv[++i]);
+                if (jpegGrid != 0 && jpegGrid != 8 && jpegGrid != 16) {
+                    std::cerr << "Error: --jpeg-grid must be 8 or 16.\n";
+                    return 1;
+                }
+            } else if (arg == "--jpeg-quality") {
+                if (i + 1 < argc) jpegQuality = std::stoi(argv[++i]);
+                if (jpegQuality < 1 || jpegQuality > 100) {
+                    std::cerr << "Error: --jpeg-quality must be between 1 and 100.\n";
+                    return 1;
+                }
+            } else if (arg == "--gif-palette") {
+                if (i + 1 < argc) {
+                    std::string mode = argv[++i];
+                    if (mode == "global") gifGlobalPalette = true;
+                    else if (mode == "frame") gifGlobalPalette = false;
+                    else {
+                        std::cerr << "Error: Invalid GIF palette mode '" << mode << "' (expected frame or global).\n";
+                        return 1;
+                    }
+                }
+            } else if (arg == "--gif-frames") {
+                if (i + 1 < argc) gifFrameCount = std::stoi(argv[++i]);
+                if (gifFrameCount <= 0) {
+                    std::cerr << "Error: --gif-frames must be positive.\n";
+                    return 1;
+                }
+            } else if (arg == "--gif-per-level") {
+                gifPerLevel = true;
+            } else if (arg == "--gif-max-dim") {
+                if (i + 1 < argc) gifMaxDimension = std::stoi(argv[++i]);
+                if (gifMaxDimension <= 0) {
+                    std::cerr << "Error: --gif-max-dim must be positive.\n";
+                    return 1;
+                }
+            } else if (arg == "--video") {
+                if (i + 1 < argc) videoPath = argv[++i];
+            } else if (arg == "--video-format") {
+                if (i + 1 < argc) videoFormatName = argv[++i];
+                if (videoFormatName != "y4m" && videoFormatName != "ppm") {
+                    std::cerr << "Error: Invalid video format '" << videoFormatName << "' (expected y4m or ppm).\n";
+                    return 1;
+                }
+            } else if (arg == "--band-height") {
+                if (i + 1 < argc) bandHeight = std::stoi(argv[++i]);
+                if (bandHeight <= 0) {
+                    std::cerr << "Error: --band-height must be positive.\n";
+                    return 1;
+                }
+            } else if (arg == "--autotune") {
+                autoTune = true;
+            } else if (arg == "--goal") {
+                if (i + 1 < argc && !AutoTuner::parseGoal(argv[++i], goalType, goalValue)) {
+                    std::cerr << "Error: Invalid goal '" << argv[i] << "' (expected psnr:<dB>, ssim:<0-1> or size:<bytes>).\n";
+                    return 1;
+                }
+            } else if (arg == "-j" || arg == "--threads") {
+                if (i + 1 < argc) threadCount = std::stoi(argv[++i]);
             }
         }
         
+        
+        // Di luar --sweep, -m/-t/-b hanya menerima satu nilai; daftar dan rentang diurai oleh mode sweep
+        if (sweepCsvPath.empty()) {
+            for (const std::string* spec : { &methodSpec, &thresholdSpec, &blockSpec }) {
+                if (spec->find_first_of(",:") != std::string::npos) {
+                    std::cerr << "Error: Lists and ranges in -m, -t and -b ('" << *spec << "') require --sweep.\n";
+                    return 1;
+                }
+            }
+            if (!methodSpec.empty()) {
+                errorMethod = getErrorMetricFromString(methodSpec);
+            }
+            if (!thresholdSpec.empty() && !parseNumber(thresholdSpec, threshold)) {
+                std::cerr << "Error: Invalid threshold '" << thresholdSpec << "'.\n";
+                return 1;
+            }
+            if (!blockSpec.empty() && !parseInteger(blockSpec, minBlockSize)) {
+                std::cerr << "Error: Invalid minimum block size '" << blockSpec << "'.\n";
+                return 1;
+            }
+        }
+
+        if (gifFrameCount > 0 && gifPerLevel) {
+            std::cerr << "Error: --gif-frames and --gif-per-level cannot be combined.\n";
+            return 1;
+        }
+
+        // Stream frame ke stdout: semua log dialihkan ke stderr agar stream tetap bersih
+        if (videoPath == "-") {
+            std::cout.rdbuf(std::cerr.rdbuf());
+        }
+
+        // Mode batch: semua gambar diproses dalam proses ini, output memakai penamaan default
+        if (!batchSpec.empty()) {
+            if (!inputPath.empty() || !outputPath.empty() || !gifPath.empty() || !videoPath.empty() || autoTune) {
+                std::cerr << "Error: --batch cannot be combined with -i, -o, -g, --video or --autotune.\n";
+                return 1;
+            }
+            if (threshold < 0) {
+                threshold = Utils::getDefaultThreshold(errorMethod);
+            }
+
+            std::vector<std::string> inputs;
+            if (!BatchProcessor::collectInputs(batchSpec, inputs)) {
+                return 1;
+            }
+            BatchProcessor batch(errorMethod, threshold, minBlockSize, targetCompression);
+            batch.setConfigure(configureProcessor);
+            return batch.run(inputs, threadCount) ? 0 : 1;
+        }
+
+        // Mode sweep: -m/-t/-b berisi daftar atau rentang, setiap kombinasi dibangun dari satu decode
+        if (!sweepCsvPath.empty()) {
+            if (!outputPath.empty() || !gifPath.empty() || !videoPath.empty() || autoTune || targetCompression > 0.0) {
+                std::cerr << "Error: --sweep cannot be combined with -o, -g, --video, -c or --autotune.\n";
+                return 1;
+            }
+            std::vector<double> values;
+            if (!Utils::parseValueList(methodSpec.empty() ? "1" : methodSpec, values)) {
+                std::cerr << "Error: Invalid method list '" << methodSpec << "'.\n";
+                return 1;
+            }
+            for (double value : values) {
+                if (value != std::floor(value) || value < 1 || value > 5) {
+                    std::cerr << "Error: Sweep methods must be between 1 and 5.\n";
+                    return 1;
+                }
+                sweepMethods.push_back(getErrorMetricFromString(std::to_string(static_cast<int>(value))));
+            }
+            if (!thresholdSpec.empty() && !Utils::parseValueList(thresholdSpec, sweepThresholds)) {
+                std::cerr << "Error: Invalid threshold list '" << thresholdSpec << "'.\n";
+                return 1;
+            }
+            if (!Utils::parseValueList(blockSpec.empty() ? std::to_string(minBlockSize) : blockSpec, values)) {
+                std::cerr << "Error: Invalid block size list '" << blockSpec << "'.\n";
+                return 1;
+            }
+            for (double value : values) {
+                if (value != std::floor(value) || value < 1) {
+                    std::cerr << "Error: Sweep block sizes must be positive integers.\n";
+                    return 1;
+                }
+                sweepBlockSizes.push_back(static_cast<int>(value));
+            }
+            minBlockSize = *std::min_element(sweepBlockSizes.begin(), sweepBlockSizes.end());
+        }
 
         if (inputPath.empty()) {
             std::cerr << "Error: Input path is required.\n";
@@ -87,14 +396,15 @@ int main(int argc, char* argv[]) {
         }
         
         
-        if (outputPath.empty()) {
+        // Pada mode autotune, path default ditentukan setelah parameter terpilih
+        if (outputPath.empty() && !autoTune && sweepCsvPath.empty()) {
             outputPath = Utils::getDefaultOutputPath(inputPath, errorMethod, 
                                                    threshold, minBlockSize, targetCompression);
             std::cout << "Using default output path: " << outputPath << std::endl;
         }
         
         
-        if (gifPath.empty() && targetCompression > 0.0) {
+        if (gifPath.empty() && targetCompression > 0.0 && !autoTune) {
             gifPath = Utils::getDefaultGifPath(inputPath, errorMethod, 
                                              threshold, minBlockSize, targetCompression);
             std::cout << "Using default GIF path: " << gifPath << std::endl;
@@ -234,6 +544,7 @@ int main(int argc, char* argv[]) {
 
     ImageProcessor processor(inputPath, outputPath, minBlockSize, threshold, 
                            errorMethod, targetCompression, gifPath);
+    configureProcessor(processor);
     
 
     printColoredText("Loading image...\n", YELLOW);
@@ -243,6 +554,19 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    if (!sweepCsvPath.empty()) {
+        printColoredText("Running parameter sweep...\n", YELLOW);
+        return processor.sweep(sweepMethods, sweepThresholds, sweepBlockSizes, sweepCsvPath) ? 0 : 1;
+    }
+    
+    if (autoTune) {
+        printColoredText("Autotuning parameters...\n", YELLOW);
+        if (!processor.autoTune(goalType, goalValue)) {
+            // Tanpa goal, autotune hanya menampilkan laporan
+            return goalType == AutoTuner::NO_GOAL ? 0 : 1;
+        }
+    }
+    
     printColoredText("Compressing image...\n", YELLOW);
     success = processor.compressImage();
     if (!success) {